@@ -0,0 +1,97 @@
+/*
+    File: ParamSync.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Control setup per kind, gesture writes, and the batched refresh.
+*/
+
+#include "ParamSync.h"
+
+using namespace juce;
+
+ParamSync::ParamSync (AudioProcessorValueTreeState& s) : state (s) {
+    const auto n = (size_t) state.processor.getParameters().size();
+    shown.assign (n, -1.0f);
+    changedFlags.assign (n, 0);
+}
+
+RangedAudioParameter* ParamSync::find (const String& paramId) const {
+    auto* param = state.getParameter (paramId);
+    jassert (param != nullptr); // unknown id
+    return param;
+}
+
+void ParamSync::bind (Slider& slider, const String& paramId) {
+    auto* param = find (paramId);
+    if (param == nullptr) return;
+
+    const auto range = param->getNormalisableRange();
+    slider.setNormalisableRange ({ (double) range.start, (double) range.end,
+                                   [range] (double, double, double v) { return (double) range.convertFrom0to1 ((float) v); },
+                                   [range] (double, double, double v) { return (double) range.convertTo0to1 ((float) v); },
+                                   [range] (double, double, double v) { return (double) range.snapToLegalValue ((float) v); } });
+    slider.setDoubleClickReturnValue (true, range.convertFrom0to1 (param->getDefaultValue()));
+    slider.textFromValueFunction = [param] (double v) { return param->getText (param->convertTo0to1 ((float) v), 0); };
+    slider.valueFromTextFunction = [param] (const String& t) { return (double) param->convertFrom0to1 (param->getValueForText (t)); };
+
+    slider.onDragStart   = [param] { param->beginChangeGesture(); };
+    slider.onDragEnd     = [param] { param->endChangeGesture(); };
+    // Wheel, keys and text entry change the value outside a drag: wrap those in their own gesture
+    slider.onValueChange = [this, param, &slider] { write (*param, param->convertTo0to1 ((float) slider.getValue()), ! slider.isMouseButtonDown()); };
+
+    bindings.push_back ({ param, &slider, Kind::Slider });
+}
+
+void ParamSync::bind (Button& button, const String& paramId) {
+    auto* param = find (paramId);
+    if (param == nullptr) return;
+    button.onClick = [this, param, &button] { write (*param, button.getToggleState() ? 1.0f : 0.0f, true); };
+    bindings.push_back ({ param, &button, Kind::Button });
+}
+
+void ParamSync::bind (ComboBox& box, const String& paramId) {
+    auto* param = find (paramId);
+    if (param == nullptr) return;
+    box.onChange = [this, param, &box] {
+        if (box.getSelectedId() > 0) write (*param, param->convertTo0to1 ((float) (box.getSelectedId() - 1)), true);
+    };
+    bindings.push_back ({ param, &box, Kind::ComboBox });
+}
+
+void ParamSync::write (RangedAudioParameter& param, float normalised, bool wholeGesture) {
+    if (wholeGesture) param.beginChangeGesture();
+    param.setValueNotifyingHost (normalised);
+    if (wholeGesture) param.endChangeGesture();
+    shown[(size_t) param.getParameterIndex()] = param.getValue(); // already on screen: no echo on the next refresh
+}
+
+void ParamSync::update (uint32 version) {
+    if (primed && version == lastVersion) return;
+    primed = true;
+    lastVersion = version;
+
+    std::fill (changedFlags.begin(), changedFlags.end(), (char) 0);
+    for (const auto& b : bindings) {
+        const auto i = (size_t) b.param->getParameterIndex();
+        const float v = b.param->getValue();
+        if (! changedFlags[i]) { // several controls may share a parameter: the first one decides
+            if (v == shown[i]) continue;
+            shown[i] = v;
+            changedFlags[i] = 1;
+        }
+        show (b, v);
+    }
+}
+
+void ParamSync::show (const Binding& b, float normalised) {
+    switch (b.kind) {
+        case Kind::Slider:
+            static_cast<Slider*> (b.control)->setValue (b.param->convertFrom0to1 (normalised), dontSendNotification); break;
+        case Kind::Button:
+            static_cast<Button*> (b.control)->setToggleState (normalised >= 0.5f, dontSendNotification); break;
+        case Kind::ComboBox:
+            static_cast<ComboBox*> (b.control)->setSelectedId (roundToInt (b.param->convertFrom0to1 (normalised)) + 1, dontSendNotification); break;
+    }
+}
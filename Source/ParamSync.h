@@ -0,0 +1,49 @@
+/*
+    File: ParamSync.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Editor-side parameter <-> control binding, in place of one APVTS
+        attachment (and parameter listener) per control. Controls write their
+        parameter directly on user gestures. The other direction is polled: the
+        editor's timer hands in the processor's parameter version and, when it
+        moved, every bound parameter is compared with the value last shown and
+        only the changed controls are updated, in one pass.
+*/
+
+#pragma once
+#include "JuceIncludes.h"
+#include <vector>
+
+class ParamSync {
+public:
+    explicit ParamSync (juce::AudioProcessorValueTreeState& state);
+
+    // Message thread, once per control. Range, text conversion, double-click default and
+    // gestures are set up as the APVTS attachments did; the value shows from the next update()
+    void bind (juce::Slider& slider, const juce::String& paramId);
+    void bind (juce::Button& button, const juce::String& paramId);
+    void bind (juce::ComboBox& box, const juce::String& paramId); // item ids 1..n = choice 0..n-1
+
+    // Message thread. No-op unless 'version' differs from the previous call (the first call
+    // always refreshes)
+    void update (juce::uint32 version);
+
+private:
+    enum class Kind { Slider, Button, ComboBox };
+    struct Binding { juce::RangedAudioParameter* param; juce::Component* control; Kind kind; };
+
+    juce::RangedAudioParameter* find (const juce::String& paramId) const;
+    void write (juce::RangedAudioParameter& param, float normalised, bool wholeGesture);
+    static void show (const Binding& b, float normalised);
+
+    juce::AudioProcessorValueTreeState& state;
+    std::vector<Binding> bindings;
+    std::vector<float> shown;          // normalised value on screen, by parameter index (-1 = never)
+    std::vector<char> changedFlags;    // by parameter index, within one update()
+    juce::uint32 lastVersion = 0;
+    bool primed = false;
+
+    JUCE_DECLARE_NON_COPYABLE (ParamSync)
+};
@@ -0,0 +1,242 @@
+/*
+    File: ParameterSpecs.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Single source of truth for the parameter set: IDs, display names,
+        ranges, defaults and choice lists, in APVTS/host order. Shared by the
+        processor layout and the build-time preset compiler (JUCE-free).
+*/
+
+#pragma once
+
+namespace ids {
+// Oscillateurs & Mix
+static constexpr auto osc1Wave = "osc1Wave";
+static constexpr auto osc2Wave = "osc2Wave";
+static constexpr auto osc3Wave = "osc3Wave";
+static constexpr auto mix1 = "mix1"; static constexpr auto mix2 = "mix2"; static constexpr auto mix3 = "mix3";
+// Detune / Stereo / Unison
+static constexpr auto detune1 = "detune1"; static constexpr auto detune2 = "detune2"; static constexpr auto detune3 = "detune3";
+static constexpr auto stereoSpread = "stereoSpread";
+static constexpr auto uniOn = "uniOn"; static constexpr auto uniDetune = "uniDetune"; static constexpr auto uniWidth = "uniWidth";
+// PWM
+static constexpr auto pwm1 = "pwm1"; static constexpr auto pwm2 = "pwm2"; static constexpr auto pwm3 = "pwm3";
+static constexpr auto pwmDepth1 = "pwmDepth1"; static constexpr auto pwmDepth2 = "pwmDepth2"; static constexpr auto pwmDepth3 = "pwmDepth3";
+static constexpr auto pwmRate1  = "pwmRate1";  static constexpr auto pwmRate2  = "pwmRate2";  static constexpr auto pwmRate3  = "pwmRate3";
+// Sub & Noise
+static constexpr auto subOn = "subOn"; static constexpr auto subWave = "subWave"; static constexpr auto subOct = "subOct";
+static constexpr auto subLevel = "subLevel"; static constexpr auto subDrive = "subDrive"; static constexpr auto subAsym = "subAsym";
+static constexpr auto mixNoiseW = "mixNoiseW"; static constexpr auto mixNoiseP = "mixNoiseP"; static constexpr auto mixNoiseB = "mixNoiseB";
+static constexpr auto noiseHPFOn = "noiseHPFOn"; static constexpr auto noiseHPF = "noiseHPF";
+// Amp ADSR
+static constexpr auto attack = "attack"; static constexpr auto decay = "decay"; static constexpr auto sustain = "sustain"; static constexpr auto release = "release";
+// Filter + Env
+static constexpr auto filterType = "filterType"; static constexpr auto cutoff = "cutoff"; static constexpr auto resonance = "resonance";
+static constexpr auto fA = "fAttack"; static constexpr auto fD = "fDecay"; static constexpr auto fS = "fSustain"; static constexpr auto fR = "fRelease"; static constexpr auto fAmt = "fAmount";
+// LFOs
+static constexpr auto lfoRate = "lfoRate"; static constexpr auto lfoDepth = "lfoDepth"; static constexpr auto lfoTarget = "lfoTarget";
+static constexpr auto lfo2Rate = "lfo2Rate"; static constexpr auto lfo2Depth = "lfo2Depth"; static constexpr auto lfo2Target = "lfo2Target";
+// Sync / FM (reserved)
+static constexpr auto sync2to1 = "sync2to1"; static constexpr auto sync3to1 = "sync3to1"; static constexpr auto fm31 = "fm31"; static constexpr auto fm32 = "fm32";
+// Global
+static constexpr auto gain = "gain"; static constexpr auto mpeEnabled = "mpeEnabled"; static constexpr auto bendRange = "bendRange";
+// Morph (A/B preset interpolation)
+static constexpr auto morphOn = "morphOn"; static constexpr auto morph = "morph";
+// Eco (CPU governor)
+static constexpr auto ecoOn = "ecoOn"; static constexpr auto ecoMaxTier = "ecoMaxTier";
+// User wavetables: frame position per oscillator
+static constexpr auto tablePos1 = "tablePos1"; static constexpr auto tablePos2 = "tablePos2"; static constexpr auto tablePos3 = "tablePos3";
+// Freeze (pre-rendered notes for static percussive patches)
+static constexpr auto freezeOn = "freezeOn";
+// Eco tier in effect (read-only, reported by the processor)
+static constexpr auto ecoTier = "ecoTier";
+// User wavetables: table replaces the wave per oscillator; LFOs sweeping the frame position
+static constexpr auto tableOn1 = "tableOn1"; static constexpr auto tableOn2 = "tableOn2"; static constexpr auto tableOn3 = "tableOn3";
+static constexpr auto lfo1Table = "lfo1Table"; static constexpr auto lfo2Table = "lfo2Table";
+}
+
+namespace params {
+
+enum class Kind { Float, Bool, Choice };
+
+// Float: NormalisableRange (start, end, interval, skew) + default.
+// Bool/Choice: start = 0, end = last index, default = index; choices are '|' separated.
+// output: read-only, written by the processor (host meter lane, never in presets).
+struct Spec {
+    const char* id; const char* name; Kind kind;
+    float start, end, interval, skew, def;
+    const char* choices;
+    bool output = false;
+};
+
+static constexpr auto waveChoices   = "Sine|Saw+|Pulse|Tri|NoiseW|Saw-|Fold|HalfS";
+static constexpr auto targetChoices = "None|Pitch|Amp|Cutoff|PWM";
+static constexpr auto ecoTierChoices = "Full|No Unison|Cheap Shapes|Slow Mod|4 Voices";
+
+constexpr Spec flt (const char* id, const char* name, float a, float b, float def, float skew = 1.0f) { return { id, name, Kind::Float, a, b, 0.0f, skew, def, nullptr }; }
+constexpr Spec bln (const char* id, const char* name, bool def) { return { id, name, Kind::Bool, 0.0f, 1.0f, 1.0f, 1.0f, def ? 1.0f : 0.0f, nullptr }; }
+constexpr Spec chc (const char* id, const char* name, const char* choices, int numChoices, int def) { return { id, name, Kind::Choice, 0.0f, (float) (numChoices - 1), 1.0f, 1.0f, (float) def, choices }; }
+constexpr Spec mtr (const char* id, const char* name, const char* choices, int numChoices) { return { id, name, Kind::Choice, 0.0f, (float) (numChoices - 1), 1.0f, 1.0f, 0.0f, choices, true }; }
+
+static constexpr Spec specs[] = {
+    // Waves
+    chc (ids::osc1Wave, "OSC1", waveChoices, 8, 1),
+    chc (ids::osc2Wave, "OSC2", waveChoices, 8, 2),
+    chc (ids::osc3Wave, "OSC3", waveChoices, 8, 0),
+
+    flt (ids::mix1, "Mix1", 0, 1, 0.7f),
+    flt (ids::mix2, "Mix2", 0, 1, 0.6f),
+    flt (ids::mix3, "Mix3", 0, 1, 0.2f),
+
+    flt (ids::detune1, "Det1 (st)", -24, 24, 0.0f),
+    flt (ids::detune2, "Det2 (st)", -24, 24, 0.0f),
+    flt (ids::detune3, "Det3 (st)", -24, 24, 0.0f),
+    flt (ids::stereoSpread, "Spread", 0, 1, 0.2f),
+
+    bln (ids::uniOn,     "Unison", true),
+    flt (ids::uniDetune, "UniDet",   0, 50, 12.0f),
+    flt (ids::uniWidth,  "UniWidth", 0, 1,  0.5f),
+
+    // PWM
+    flt (ids::pwm1, "PWM1", 0.05f, 0.95f, 0.5f),
+    flt (ids::pwm2, "PWM2", 0.05f, 0.95f, 0.5f),
+    flt (ids::pwm3, "PWM3", 0.05f, 0.95f, 0.5f),
+    flt (ids::pwmDepth1, "PWM1 Depth", 0, 1, 0.3f),
+    flt (ids::pwmDepth2, "PWM2 Depth", 0, 1, 0.3f),
+    flt (ids::pwmDepth3, "PWM3 Depth", 0, 1, 0.3f),
+    flt (ids::pwmRate1,  "PWM1 Rate",  0.05f, 10.0f, 1.2f, 0.4f),
+    flt (ids::pwmRate2,  "PWM2 Rate",  0.05f, 10.0f, 0.8f, 0.4f),
+    flt (ids::pwmRate3,  "PWM3 Rate",  0.05f, 10.0f, 0.6f, 0.4f),
+
+    // Sub & Noise
+    bln (ids::subOn,    "Sub On", true),
+    chc (ids::subWave,  "Sub Wave", "Sine|Square|Tri", 3, 1),
+    chc (ids::subOct,   "Sub Oct",  "-1|-2", 2, 1),
+    flt (ids::subLevel, "Sub Level", 0, 1,  0.35f),
+    flt (ids::subDrive, "Sub Drive", 0, 24, 6.0f),
+    bln (ids::subAsym,  "Sub Asym", false),
+
+    flt (ids::mixNoiseW, "White", 0, 1, 0.0f),
+    flt (ids::mixNoiseP, "Pink",  0, 1, 0.0f),
+    flt (ids::mixNoiseB, "Brown", 0, 1, 0.0f),
+    bln (ids::noiseHPFOn, "Noise HPF", false),
+    flt (ids::noiseHPF,   "HPF Hz", 20.0f, 2000.0f, 120.0f, 0.4f),
+
+    // Amp ADSR
+    flt (ids::attack,  "Attack",  0.001f, 3.0f, 0.01f, 0.5f),
+    flt (ids::decay,   "Decay",   0.001f, 3.0f, 0.12f, 0.5f),
+    flt (ids::sustain, "Sustain", 0.0f,   1.0f, 0.8f),
+    flt (ids::release, "Release", 0.001f, 4.0f, 0.25f, 0.5f),
+
+    // Filter + Env
+    chc (ids::filterType, "Filter", "LP|BP|HP", 3, 0),
+    flt (ids::cutoff,    "Cutoff", 20.0f, 20000.0f, 12000.0f, 0.3f),
+    flt (ids::resonance, "Q", 0.1f, 10.0f, 0.7f, 0.5f),
+    flt (ids::fA, "F-Attack",  0.001f, 3.0f, 0.01f, 0.5f),
+    flt (ids::fD, "F-Decay",   0.001f, 3.0f, 0.12f, 0.5f),
+    flt (ids::fS, "F-Sustain", 0.0f,   1.0f, 0.0f),
+    flt (ids::fR, "F-Release", 0.001f, 4.0f, 0.25f, 0.5f),
+    flt (ids::fAmt, "F-Amount", 0.0f,  1.0f, 0.0f),
+
+    // LFOs
+    flt (ids::lfoRate,   "LFO1 Rate",  0.05f, 20.0f, 5.0f, 0.5f),
+    flt (ids::lfoDepth,  "LFO1 Depth", 0.0f,  1.0f,  0.3f),
+    chc (ids::lfoTarget, "LFO1 Target", targetChoices, 5, 0),
+    flt (ids::lfo2Rate,   "LFO2 Rate",  0.05f, 20.0f, 0.8f, 0.5f),
+    flt (ids::lfo2Depth,  "LFO2 Depth", 0.0f,  1.0f,  0.2f),
+    chc (ids::lfo2Target, "LFO2 Target", targetChoices, 5, 0),
+
+    // Sync / FM (reserved)
+    bln (ids::sync2to1, "Sync 2-1", false),
+    bln (ids::sync3to1, "Sync 3-1", false),
+    flt (ids::fm31, "FM 3-1 (st)", 0.0f, 24.0f, 0.0f),
+    flt (ids::fm32, "FM 3-2 (st)", 0.0f, 24.0f, 0.0f),
+
+    // Global
+    flt (ids::gain,       "Gain", -24.0f, 6.0f, -6.0f),
+    bln (ids::mpeEnabled, "MPE", true),
+    flt (ids::bendRange,  "Bend", 1.0f, 48.0f, 48.0f),
+
+    // Morph (A/B preset interpolation)
+    bln (ids::morphOn, "Morph On", false),
+    flt (ids::morph,   "Morph", 0.0f, 1.0f, 0.0f),
+
+    // Eco: quality tiers the governor may step down to under CPU load
+    bln (ids::ecoOn,      "Eco", false),
+    chc (ids::ecoMaxTier, "Eco Max Tier", ecoTierChoices, 5, 4),
+
+    // User wavetables: 0 = first frame, 1 = last (LFOs switched to Table sweep around it)
+    flt (ids::tablePos1, "Table1 Pos", 0.0f, 1.0f, 0.0f),
+    flt (ids::tablePos2, "Table2 Pos", 0.0f, 1.0f, 0.0f),
+    flt (ids::tablePos3, "Table3 Pos", 0.0f, 1.0f, 0.0f),
+
+    // Freeze: replay stored renders of each note when the patch allows it (see NoteCache)
+    bln (ids::freezeOn, "Freeze", false),
+
+    // Eco tier the governor is rendering at, for host automation lanes
+    mtr (ids::ecoTier, "Eco Tier", ecoTierChoices, 5),
+
+    // User wavetables: separate switches, so the wave and LFO target lists keep their
+    // normalised values in existing sessions and automation
+    bln (ids::tableOn1,  "Table1 On", false),
+    bln (ids::tableOn2,  "Table2 On", false),
+    bln (ids::tableOn3,  "Table3 On", false),
+    bln (ids::lfo1Table, "LFO1 > Table", false),
+    bln (ids::lfo2Table, "LFO2 > Table", false),
+};
+
+static constexpr int count = (int) (sizeof (specs) / sizeof (specs[0]));
+
+constexpr bool sameId (const char* a, const char* b) {
+    while (*a != 0 && *a == *b) { ++a; ++b; }
+    return *a == *b;
+}
+
+// Parameter index (APVTS/host order) for an ID, or -1. Usable in constant expressions.
+constexpr int indexOf (const char* id) {
+    for (int i = 0; i < count; ++i)
+        if (sameId (specs[i].id, id)) return i;
+    return -1;
+}
+
+// Compile-time indices, one per ID above.
+namespace idx {
+static constexpr int osc1Wave = indexOf (ids::osc1Wave), osc2Wave = indexOf (ids::osc2Wave), osc3Wave = indexOf (ids::osc3Wave);
+static constexpr int mix1 = indexOf (ids::mix1), mix2 = indexOf (ids::mix2), mix3 = indexOf (ids::mix3);
+static constexpr int detune1 = indexOf (ids::detune1), detune2 = indexOf (ids::detune2), detune3 = indexOf (ids::detune3);
+static constexpr int stereoSpread = indexOf (ids::stereoSpread);
+static constexpr int uniOn = indexOf (ids::uniOn), uniDetune = indexOf (ids::uniDetune), uniWidth = indexOf (ids::uniWidth);
+static constexpr int pwm1 = indexOf (ids::pwm1), pwm2 = indexOf (ids::pwm2), pwm3 = indexOf (ids::pwm3);
+static constexpr int pwmDepth1 = indexOf (ids::pwmDepth1), pwmDepth2 = indexOf (ids::pwmDepth2), pwmDepth3 = indexOf (ids::pwmDepth3);
+static constexpr int pwmRate1 = indexOf (ids::pwmRate1), pwmRate2 = indexOf (ids::pwmRate2), pwmRate3 = indexOf (ids::pwmRate3);
+static constexpr int subOn = indexOf (ids::subOn), subWave = indexOf (ids::subWave), subOct = indexOf (ids::subOct);
+static constexpr int subLevel = indexOf (ids::subLevel), subDrive = indexOf (ids::subDrive), subAsym = indexOf (ids::subAsym);
+static constexpr int mixNoiseW = indexOf (ids::mixNoiseW), mixNoiseP = indexOf (ids::mixNoiseP), mixNoiseB = indexOf (ids::mixNoiseB);
+static constexpr int noiseHPFOn = indexOf (ids::noiseHPFOn), noiseHPF = indexOf (ids::noiseHPF);
+static constexpr int attack = indexOf (ids::attack), decay = indexOf (ids::decay), sustain = indexOf (ids::sustain), release = indexOf (ids::release);
+static constexpr int filterType = indexOf (ids::filterType), cutoff = indexOf (ids::cutoff), resonance = indexOf (ids::resonance);
+static constexpr int fA = indexOf (ids::fA), fD = indexOf (ids::fD), fS = indexOf (ids::fS), fR = indexOf (ids::fR), fAmt = indexOf (ids::fAmt);
+static constexpr int lfoRate = indexOf (ids::lfoRate), lfoDepth = indexOf (ids::lfoDepth), lfoTarget = indexOf (ids::lfoTarget);
+static constexpr int lfo2Rate = indexOf (ids::lfo2Rate), lfo2Depth = indexOf (ids::lfo2Depth), lfo2Target = indexOf (ids::lfo2Target);
+static constexpr int sync2to1 = indexOf (ids::sync2to1), sync3to1 = indexOf (ids::sync3to1), fm31 = indexOf (ids::fm31), fm32 = indexOf (ids::fm32);
+static constexpr int gain = indexOf (ids::gain), mpeEnabled = indexOf (ids::mpeEnabled), bendRange = indexOf (ids::bendRange);
+static constexpr int morphOn = indexOf (ids::morphOn), morph = indexOf (ids::morph);
+static constexpr int ecoOn = indexOf (ids::ecoOn), ecoMaxTier = indexOf (ids::ecoMaxTier);
+static constexpr int tablePos1 = indexOf (ids::tablePos1), tablePos2 = indexOf (ids::tablePos2), tablePos3 = indexOf (ids::tablePos3);
+static constexpr int freezeOn = indexOf (ids::freezeOn);
+static constexpr int ecoTier = indexOf (ids::ecoTier);
+static constexpr int tableOn1 = indexOf (ids::tableOn1), tableOn2 = indexOf (ids::tableOn2), tableOn3 = indexOf (ids::tableOn3);
+static constexpr int lfo1Table = indexOf (ids::lfo1Table), lfo2Table = indexOf (ids::lfo2Table);
+}
+
+// Plain (denormalised) values for one audio block, in spec order. Filled once per
+// block by the processor (from the APVTS atomics or the morph engine); voices read
+// this instead of looking parameters up by ID.
+struct Block {
+    float values[count] {};
+    float operator[] (int i) const { return values[i]; }
+};
+
+} // namespace params
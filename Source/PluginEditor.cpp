@@ -12,6 +12,8 @@
 
 #include "PluginEditor.h"
 #include "BinaryData.h"
+#include "PresetBrowser.h"
+#include "presets/PresetIndex.h"
 
 
 using namespace juce;
@@ -117,7 +119,7 @@ MiniSynthAudioProcessorEditor::MiniSynthAudioProcessorEditor (MiniSynthAudioProc
     setSize (1300, 900);
 
     // Presets bar
-    addAndMakeVisible (presetBox);
+    addAndMakeVisible (presetBtn);
     addAndMakeVisible (saveBtn); addAndMakeVisible (deleteBtn); addAndMakeVisible (reloadBtn);
 
     // ---- SAVE (async FileChooser, pas de modal loop bloquante) ----
@@ -133,11 +135,13 @@ MiniSynthAudioProcessorEditor::MiniSynthAudioProcessorEditor (MiniSynthAudioProc
             auto f = fc.getResult();
             if (f.getFullPathName().isNotEmpty())
             {
-                auto name = f.getFileNameWithoutExtension().trim();
+                auto name = f.getFileNameWithoutExtension().upToFirstOccurrenceOf (".minisynth", false, true).trim();
                 if (name.isNotEmpty())
                 {
-                    if (processor.saveUserPreset (name))
-                        refreshPresetBox();
+                    if (processor.saveUserPreset (name)) {
+                        currentPreset = processor.getPresetNames().indexOf (name);
+                        refreshPresetButton();
+                    }
                 }
             }
         });
@@ -145,9 +149,10 @@ MiniSynthAudioProcessorEditor::MiniSynthAudioProcessorEditor (MiniSynthAudioProc
 
     // ---- DELETE (NativeMessageBox avec signature complète) ----
     deleteBtn.onClick = [this] {
-        const int idx = presetBox.getSelectedItemIndex();
-        if (idx < 0) return;
-        auto name = presetBox.getText();
+        const int idx = currentPreset;
+        if (processor.isFactoryPreset (idx)) return;
+        auto name = processor.getPresetIndex().getInfo (idx).name;
+        if (name.isEmpty()) return;
 
         const bool ok = juce::NativeMessageBox::showOkCancelBox(
             juce::MessageBoxIconType::WarningIcon,
@@ -158,14 +163,40 @@ MiniSynthAudioProcessorEditor::MiniSynthAudioProcessorEditor (MiniSynthAudioProc
         );
 
         if (ok) {
-            if (processor.deleteUserPreset (name))
-                refreshPresetBox();
+            if (processor.deleteUserPreset (name)) {
+                currentPreset = 0;
+                refreshPresetButton();
+            }
         }
     };
 
-    reloadBtn.onClick = [this] { refreshPresetBox(); };
-    presetBox.onChange = [this] { auto idx = presetBox.getSelectedItemIndex(); if (idx >= 0) processor.applyPresetByIndex (idx); };
-    refreshPresetBox();
+    reloadBtn.onClick = [this] { refreshPresetButton(); };
+    presetBtn.onClick = [this] {
+        PresetBrowser::show (presetBtn, *this, processor.getPresetIndex(), currentPreset, [this] (int idx) {
+            currentPreset = idx;
+            processor.applyPresetByIndex (idx); syncControls();
+            refreshPresetButton();
+        });
+    };
+    refreshPresetButton();
+
+    // Morph
+    for (auto* c : std::initializer_list<Component*> { &morphABtn, &morphBBtn, &morphOn, &morph }) addAndMakeVisible (*c);
+    morph.setSliderStyle (Slider::LinearHorizontal);
+    morph.setTextBoxStyle (Slider::NoTextBox, false, 0, 0);
+    morphABtn.onClick = [this] { processor.setMorphSlot (0, currentPreset); };
+    morphBBtn.onClick = [this] { processor.setMorphSlot (1, currentPreset); };
+    paramSync.bind (morph, ids::morph);
+    paramSync.bind (morphOn, ids::morphOn);
+
+    // Audio-thread timing
+    addAndMakeVisible (loadLabel); addAndMakeVisible (timingBtn);
+    loadLabel.setFont (loadLabel.getFont().withHeight (12.0f));
+    timingBtn.onClick = [this] { showTimingMenu(); };
+    addAndMakeVisible (partsBtn);
+    partsBtn.onClick = [this] { showPartsMenu(); };
+    addAndMakeVisible (tuningBtn);
+    tuningBtn.onClick = [this] { showTuningMenu(); };
 
     // Branding image (optional): looks for brand.png or logo.png in user preset dir
     addAndMakeVisible (brandImage);
@@ -179,7 +210,7 @@ MiniSynthAudioProcessorEditor::MiniSynthAudioProcessorEditor (MiniSynthAudioProc
     // isCompact = false;
     
       addAndMakeVisible (compactToggle); compactToggle.setToggleState (true, dontSendNotification);
-    compactToggle.onClick = [this]{ isCompact = compactToggle.getToggleState(); resized(); };
+    compactToggle.onClick = [this]{ isCompact = compactToggle.getToggleState(); updateVisibility(); resized(); };
   
 
     // Always visible
@@ -190,16 +221,16 @@ MiniSynthAudioProcessorEditor::MiniSynthAudioProcessorEditor (MiniSynthAudioProc
     w3.addItemList (StringArray{ "Sine","Saw+","Pulse","Tri","NoiseW","Saw-","Fold","HalfS" }, 1);
     filtType.addItemList (StringArray{ "LP","BP","HP" }, 1);
     
-    aW1 = std::make_unique<CAttach> (processor.apvts, ids::osc1Wave, w1);
-    aW2 = std::make_unique<CAttach> (processor.apvts, ids::osc2Wave, w2);
-    aW3 = std::make_unique<CAttach> (processor.apvts, ids::osc3Wave, w3);
-    aFiltType = std::make_unique<CAttach> (processor.apvts, ids::filterType, filtType);
-    aMix1 = std::make_unique<Attach> (processor.apvts, ids::mix1, mix1);
-    aMix2 = std::make_unique<Attach> (processor.apvts, ids::mix2, mix2);
-    aMix3 = std::make_unique<Attach> (processor.apvts, ids::mix3, mix3);
-    aCut  = std::make_unique<Attach> (processor.apvts, ids::cutoff, cutoff);
-    aQ    = std::make_unique<Attach> (processor.apvts, ids::resonance, resonance);
-    aGain = std::make_unique<Attach> (processor.apvts, ids::gain, gain);
+    paramSync.bind (w1, ids::osc1Wave);
+    paramSync.bind (w2, ids::osc2Wave);
+    paramSync.bind (w3, ids::osc3Wave);
+    paramSync.bind (filtType, ids::filterType);
+    paramSync.bind (mix1, ids::mix1);
+    paramSync.bind (mix2, ids::mix2);
+    paramSync.bind (mix3, ids::mix3);
+    paramSync.bind (cutoff, ids::cutoff);
+    paramSync.bind (resonance, ids::resonance);
+    paramSync.bind (gain, ids::gain);
 
     // Advanced
     for (auto* s : { &det1,&det2,&det3,&uniDet,&uniWidth,&spread,
@@ -214,63 +245,83 @@ MiniSynthAudioProcessorEditor::MiniSynthAudioProcessorEditor (MiniSynthAudioProc
     for (auto* b : { &uniOn, &subOn, &subAsym, &noiseHPFOn, &sync21, &sync31 }) addAndMakeVisible (*b);
     for (auto* cb : { &subWave, &subOct, &lfo1Target, &lfo2Target }) addAndMakeVisible (*cb);
 
-    aDet1 = std::make_unique<Attach> (processor.apvts, ids::detune1, det1);
-    aDet2 = std::make_unique<Attach> (processor.apvts, ids::detune2, det2);
-    aDet3 = std::make_unique<Attach> (processor.apvts, ids::detune3, det3);
-    aSpread = std::make_unique<Attach> (processor.apvts, ids::stereoSpread, spread);
-    aUniOn  = std::make_unique<BAttach> (processor.apvts, ids::uniOn, uniOn);
-    aUniDet = std::make_unique<Attach> (processor.apvts, ids::uniDetune, uniDet);
-    aUniWidth = std::make_unique<Attach> (processor.apvts, ids::uniWidth, uniWidth);
-
-    aPWM1 = std::make_unique<Attach> (processor.apvts, ids::pwm1, pwm1);
-    aPWM2 = std::make_unique<Attach> (processor.apvts, ids::pwm2, pwm2);
-    aPWM3 = std::make_unique<Attach> (processor.apvts, ids::pwm3, pwm3);
-    aPWMD1= std::make_unique<Attach> (processor.apvts, ids::pwmDepth1, pwmD1);
-    aPWMD2= std::make_unique<Attach> (processor.apvts, ids::pwmDepth2, pwmD2);
-    aPWMD3= std::make_unique<Attach> (processor.apvts, ids::pwmDepth3, pwmD3);
-    aPWMR1= std::make_unique<Attach> (processor.apvts, ids::pwmRate1,  pwmR1);
-    aPWMR2= std::make_unique<Attach> (processor.apvts, ids::pwmRate2,  pwmR2);
-    aPWMR3= std::make_unique<Attach> (processor.apvts, ids::pwmRate3,  pwmR3);
-
-    aSubOn   = std::make_unique<BAttach> (processor.apvts, ids::subOn, subOn);
-    aSubAsym = std::make_unique<BAttach> (processor.apvts, ids::subAsym, subAsym);
-    aSubLevel= std::make_unique<Attach> (processor.apvts, ids::subLevel, subLevel);
-    aSubDrive= std::make_unique<Attach> (processor.apvts, ids::subDrive, subDrive);
-    aSubWave = std::make_unique<CAttach> (processor.apvts, ids::subWave, subWave);
-    aSubOct  = std::make_unique<CAttach> (processor.apvts, ids::subOct,  subOct);
+    paramSync.bind (det1, ids::detune1);
+    paramSync.bind (det2, ids::detune2);
+    paramSync.bind (det3, ids::detune3);
+    paramSync.bind (spread, ids::stereoSpread);
+    paramSync.bind (uniOn, ids::uniOn);
+    paramSync.bind (uniDet, ids::uniDetune);
+    paramSync.bind (uniWidth, ids::uniWidth);
+
+    paramSync.bind (pwm1, ids::pwm1);
+    paramSync.bind (pwm2, ids::pwm2);
+    paramSync.bind (pwm3, ids::pwm3);
+    paramSync.bind (pwmD1, ids::pwmDepth1);
+    paramSync.bind (pwmD2, ids::pwmDepth2);
+    paramSync.bind (pwmD3, ids::pwmDepth3);
+    paramSync.bind (pwmR1, ids::pwmRate1);
+    paramSync.bind (pwmR2, ids::pwmRate2);
+    paramSync.bind (pwmR3, ids::pwmRate3);
+
+    paramSync.bind (subOn, ids::subOn);
+    paramSync.bind (subAsym, ids::subAsym);
+    paramSync.bind (subLevel, ids::subLevel);
+    paramSync.bind (subDrive, ids::subDrive);
+    paramSync.bind (subWave, ids::subWave);
+    paramSync.bind (subOct, ids::subOct);
     subWave.addItemList (StringArray{ "Sine","Square","Tri" }, 1);
     subOct.addItemList  (StringArray{ "-1","-2" }, 1);
 
-    aNoiseW  = std::make_unique<Attach> (processor.apvts, ids::mixNoiseW, noiseW);
-    aNoiseP  = std::make_unique<Attach> (processor.apvts, ids::mixNoiseP, noiseP);
-    aNoiseB  = std::make_unique<Attach> (processor.apvts, ids::mixNoiseB, noiseB);
-    aNoiseHPF= std::make_unique<Attach> (processor.apvts, ids::noiseHPF,  noiseHPF);
-    aNoiseHPFOn = std::make_unique<BAttach> (processor.apvts, ids::noiseHPFOn, noiseHPFOn);
-
-    aAA = std::make_unique<Attach> (processor.apvts, ids::attack,  aA);
-    aAD = std::make_unique<Attach> (processor.apvts, ids::decay,   aD);
-    aAS = std::make_unique<Attach> (processor.apvts, ids::sustain, aS);
-    aAR = std::make_unique<Attach> (processor.apvts, ids::release, aR);
-
-    aFA = std::make_unique<Attach> (processor.apvts, ids::fA, fA);
-    aFD = std::make_unique<Attach> (processor.apvts, ids::fD, fD);
-    aFS = std::make_unique<Attach> (processor.apvts, ids::fS, fS);
-    aFR = std::make_unique<Attach> (processor.apvts, ids::fR, fR);
-    aFAmt = std::make_unique<Attach> (processor.apvts, ids::fAmt, fAmt);
-
-    aLfo1Rate = std::make_unique<Attach> (processor.apvts, ids::lfoRate,  lfo1Rate);
-    aLfo1Depth= std::make_unique<Attach> (processor.apvts, ids::lfoDepth, lfo1Depth);
-    aLfo2Rate = std::make_unique<Attach> (processor.apvts, ids::lfo2Rate, lfo2Rate);
-    aLfo2Depth= std::make_unique<Attach> (processor.apvts, ids::lfo2Depth, lfo2Depth);
-    aLfo1T = std::make_unique<CAttach> (processor.apvts, ids::lfoTarget,  lfo1Target);
-    aLfo2T = std::make_unique<CAttach> (processor.apvts, ids::lfo2Target, lfo2Target);
+    paramSync.bind (noiseW, ids::mixNoiseW);
+    paramSync.bind (noiseP, ids::mixNoiseP);
+    paramSync.bind (noiseB, ids::mixNoiseB);
+    paramSync.bind (noiseHPF, ids::noiseHPF);
+    paramSync.bind (noiseHPFOn, ids::noiseHPFOn);
+
+    paramSync.bind (aA, ids::attack);
+    paramSync.bind (aD, ids::decay);
+    paramSync.bind (aS, ids::sustain);
+    paramSync.bind (aR, ids::release);
+
+    paramSync.bind (fA, ids::fA);
+    paramSync.bind (fD, ids::fD);
+    paramSync.bind (fS, ids::fS);
+    paramSync.bind (fR, ids::fR);
+    paramSync.bind (fAmt, ids::fAmt);
+
+    paramSync.bind (lfo1Rate, ids::lfoRate);
+    paramSync.bind (lfo1Depth, ids::lfoDepth);
+    paramSync.bind (lfo2Rate, ids::lfo2Rate);
+    paramSync.bind (lfo2Depth, ids::lfo2Depth);
+    paramSync.bind (lfo1Target, ids::lfoTarget);
+    paramSync.bind (lfo2Target, ids::lfo2Target);
     lfo1Target.addItemList (StringArray{ "None","Pitch","Amp","Cutoff","PWM" }, 1);
     lfo2Target.addItemList (StringArray{ "None","Pitch","Amp","Cutoff","PWM" }, 1);
 
-    aSync21 = std::make_unique<BAttach> (processor.apvts, ids::sync2to1, sync21);
-    aSync31 = std::make_unique<BAttach> (processor.apvts, ids::sync3to1, sync31);
-    aFM31   = std::make_unique<Attach> (processor.apvts, ids::fm31, fm31);
-    aFM32   = std::make_unique<Attach> (processor.apvts, ids::fm32, fm32);
+    paramSync.bind (sync21, ids::sync2to1);
+    paramSync.bind (sync31, ids::sync3to1);
+    paramSync.bind (fm31, ids::fm31);
+    paramSync.bind (fm32, ids::fm32);
+
+    addAndMakeVisible (ecoOn); addAndMakeVisible (ecoMaxTier);
+    ecoMaxTier.addItemList (StringArray::fromTokens (params::ecoTierChoices, "|", ""), 1);
+    paramSync.bind (ecoOn, ids::ecoOn);
+    paramSync.bind (ecoMaxTier, ids::ecoMaxTier);
+    addAndMakeVisible (freezeOn);
+    paramSync.bind (freezeOn, ids::freezeOn);
+
+    for (auto* s : { &tPos1, &tPos2, &tPos3 }) { addAndMakeVisible (*s); styleKnob (*s, this); }
+    paramSync.bind (tPos1, ids::tablePos1);
+    paramSync.bind (tPos2, ids::tablePos2);
+    paramSync.bind (tPos3, ids::tablePos3);
+    for (auto* b : { &tOn1, &tOn2, &tOn3, &lfo1Table, &lfo2Table }) addAndMakeVisible (*b);
+    paramSync.bind (tOn1, ids::tableOn1);
+    paramSync.bind (tOn2, ids::tableOn2);
+    paramSync.bind (tOn3, ids::tableOn3);
+    paramSync.bind (lfo1Table, ids::lfo1Table);
+    paramSync.bind (lfo2Table, ids::lfo2Table);
+    for (int i = 0; i < 3; ++i) { addAndMakeVisible (tableBtn[i]); tableBtn[i].onClick = [this, i] { showTableMenu (i); }; }
+    refreshTableButtons();
 
     // --- Labels for knobs ---
     addKnobLabel (mix1,        "Mix 1");
@@ -343,20 +394,28 @@ MiniSynthAudioProcessorEditor::MiniSynthAudioProcessorEditor (MiniSynthAudioProc
     addControlLabel (noiseHPFOn, "Noise HPF");
     addControlLabel (sync21,     "Sync 2-1");
     addControlLabel (sync31,     "Sync 3-1");
+    addControlLabel (ecoOn,      "Eco");
+    addControlLabel (ecoMaxTier, "Eco Max");
+    addControlLabel (freezeOn,   "Freeze");
+    addControlLabel (tOn1,       "Table 1");
+    addControlLabel (tOn2,       "Table 2");
+    addControlLabel (tOn3,       "Table 3");
+    addControlLabel (lfo1Table,  "LFO1 Table");
+    addControlLabel (lfo2Table,  "LFO2 Table");
 
     // Ensure labels and controls are laid out correctly on first show
     isCompact = compactToggle.getToggleState();
-    
+    paramSync.update (processor.getParamVersion());
+    updateVisibility();
     resized();
 
     startTimerHz (20);
 }
 
-void MiniSynthAudioProcessorEditor::refreshPresetBox() {
-    presetBox.clear (dontSendNotification);
-    auto names = processor.getPresetNames();
-    for (int i = 0; i < names.size(); ++i) presetBox.addItem (names[i], i + 1);
-    presetBox.setSelectedItemIndex (0, dontSendNotification);
+void MiniSynthAudioProcessorEditor::refreshPresetButton() {
+    const auto& index = processor.getPresetIndex();
+    currentPreset = jlimit (0, jmax (0, index.size() - 1), currentPreset);
+    presetBtn.setButtonText (index.getInfo (currentPreset).name + "  ...");
 }
 
 void MiniSynthAudioProcessorEditor::paint (Graphics& g) {
@@ -380,7 +439,9 @@ void MiniSynthAudioProcessorEditor::updateVisibility()
         &fA,&fD,&fS,&fR,&fAmt,
         &lfo1Rate,&lfo1Depth,&lfo1Target,&lfo2Rate,&lfo2Depth,&lfo2Target,
         &uniOn,&uniDet,&uniWidth,
-        &sync21,&sync31,&fm31,&fm32
+        &sync21,&sync31,&fm31,&fm32,
+        &ecoOn,&ecoMaxTier,&freezeOn,
+        &tOn1,&tOn2,&tOn3,&tPos1,&tPos2,&tPos3,&tableBtn[0],&tableBtn[1],&tableBtn[2],&lfo1Table,&lfo2Table
     };
 
     // Sous-ensemble voulu en mode "compact" (Capture 1)
@@ -403,6 +464,11 @@ void MiniSynthAudioProcessorEditor::updateVisibility()
     }
 }
 
+// Parameter values -> controls, batched
+void MiniSynthAudioProcessorEditor::syncControls() {
+    paramSync.update (processor.getParamVersion());
+}
+
 static void placeRow (std::initializer_list<Component*> comps, Rectangle<int> area, int w=110) {
     int pad = 6; int x = area.getX();
     for (auto* c : comps) { c->setBounds (Rectangle<int> (x, area.getY(), w, area.getHeight()).reduced (4)); x += w + pad; }
@@ -426,13 +492,19 @@ void MiniSynthAudioProcessorEditor::resized() {
 
     // Presets bar
     auto bar = r.removeFromTop (26);
-    presetBox.setBounds (bar.removeFromLeft (260).reduced (2));
+    presetBtn.setBounds (bar.removeFromLeft (260).reduced (2));
     saveBtn.setBounds   (bar.removeFromLeft (70).reduced (2));
     deleteBtn.setBounds (bar.removeFromLeft (70).reduced (2));
     reloadBtn.setBounds (bar.removeFromLeft (70).reduced (2));
     compactToggle.setBounds (bar.removeFromLeft (100).reduced (2));
-
-    updateVisibility();
+    morphABtn.setBounds (bar.removeFromLeft (60).reduced (2));
+    morphBBtn.setBounds (bar.removeFromLeft (60).reduced (2));
+    morphOn.setBounds   (bar.removeFromLeft (80).reduced (2));
+    morph.setBounds     (bar.removeFromLeft (200).reduced (2));
+    timingBtn.setBounds (bar.removeFromRight (60).reduced (2));
+    partsBtn.setBounds  (bar.removeFromRight (60).reduced (2));
+    tuningBtn.setBounds (bar.removeFromRight (60).reduced (2));
+    loadLabel.setBounds (bar.reduced (2));
 
     // Reserve a right column for the branding image, then lay out controls on the left
     auto working = r; // remaining area below the toolbar
@@ -463,22 +535,22 @@ void MiniSynthAudioProcessorEditor::layoutCompact (Rectangle<int> r) {
 
 void MiniSynthAudioProcessorEditor::layoutFull (Rectangle<int> r) {
     auto row1 = r.removeFromTop (120);
-    placeRow ({ &w1,&mix1,&det1,&pwm1,&pwmD1,&pwmR1 }, row1);
+    placeRow ({ &w1,&mix1,&det1,&pwm1,&pwmD1,&pwmR1,&tOn1,&tPos1,&tableBtn[0] }, row1);
 
     auto row2 = r.removeFromTop (120);
-    placeRow ({ &w2,&mix2,&det2,&pwm2,&pwmD2,&pwmR2 }, row2);
+    placeRow ({ &w2,&mix2,&det2,&pwm2,&pwmD2,&pwmR2,&tOn2,&tPos2,&tableBtn[1] }, row2);
 
     auto row3 = r.removeFromTop (120);
-    placeRow ({ &w3,&mix3,&det3,&pwm3,&pwmD3,&pwmR3 }, row3);
+    placeRow ({ &w3,&mix3,&det3,&pwm3,&pwmD3,&pwmR3,&tOn3,&tPos3,&tableBtn[2] }, row3);
 
     auto row4 = r.removeFromTop (120);
-    placeRow ({ &uniOn,&uniDet,&uniWidth,&spread,&sync21,&sync31,&fm31,&fm32 }, row4);
+    placeRow ({ &uniOn,&uniDet,&uniWidth,&spread,&sync21,&sync31,&fm31,&fm32,&ecoOn,&ecoMaxTier }, row4);
 
     auto row5 = r.removeFromTop (120);
-    placeRow ({ &filtType,&cutoff,&resonance,&fAmt,&fA,&fD,&fS,&fR }, row5);
+    placeRow ({ &filtType,&cutoff,&resonance,&fAmt,&fA,&fD,&fS,&fR,&freezeOn }, row5);
 
     auto row6 = r.removeFromTop (120);
-    placeRow ({ &aA,&aD,&aS,&aR,&lfo1Rate,&lfo1Depth,&lfo1Target,&lfo2Rate,&lfo2Depth,&lfo2Target }, row6, 100);
+    placeRow ({ &aA,&aD,&aS,&aR,&lfo1Rate,&lfo1Depth,&lfo1Target,&lfo1Table,&lfo2Rate,&lfo2Depth,&lfo2Target,&lfo2Table }, row6, 100);
 
     auto row7 = r.removeFromTop (120);
     placeRow ({ &subOn,&subWave,&subOct,&subLevel,&subDrive,&subAsym,&noiseW,&noiseP,&noiseB,&noiseHPFOn,&noiseHPF,&gain }, row7, 100);
@@ -490,6 +562,141 @@ void MiniSynthAudioProcessorEditor::layoutFull (Rectangle<int> r) {
 
 }
 
+void MiniSynthAudioProcessorEditor::refreshTableButtons() {
+    for (int i = 0; i < 3; ++i) {
+        const auto f = processor.getWavetableFile (i);
+        tableBtn[i].setButtonText (processor.isWavetableImporting (i) ? "Importing..."
+                                   : f == File() ? "Table..." : f.getFileNameWithoutExtension());
+        tableBtn[i].setTooltip (f.getFullPathName());
+    }
+}
+
+void MiniSynthAudioProcessorEditor::showTableMenu (int osc) {
+    PopupMenu m;
+    m.addItem (1, "Load wavetable...");
+    const auto current = processor.getWavetableFile (osc);
+    m.addItem (2, current == File() ? String ("Clear") : "Clear " + current.getFileName(), current != File());
+
+    m.showMenuAsync (PopupMenu::Options().withTargetComponent (tableBtn[osc]), [this, osc] (int result) {
+        if (result == 2) { processor.clearWavetable (osc); refreshTableButtons(); }
+        if (result != 1) return;
+
+        tableChooser = std::make_unique<FileChooser> ("Load wavetable for OSC" + String (osc + 1), processor.getWavetableFile (osc), "*.wav");
+        tableChooser->launchAsync (FileBrowserComponent::openMode | FileBrowserComponent::canSelectFiles, [this, osc] (const FileChooser& fc) {
+            const auto f = fc.getResult();
+            if (f == File()) return;
+            String error;
+            const char* onIds[] { ids::tableOn1, ids::tableOn2, ids::tableOn3 };
+            if (processor.loadWavetable (osc, f, error))
+                processor.apvts.getParameter (onIds[osc])->setValueNotifyingHost (1.0f); // play what was just loaded
+            else
+                NativeMessageBox::showMessageBoxAsync (MessageBoxIconType::WarningIcon, "Wavetable", f.getFileName() + ": " + error);
+            refreshTableButtons();
+        });
+    });
+}
+
+void MiniSynthAudioProcessorEditor::showTimingMenu() {
+    PopupMenu m;
+    m.addItem (1, "Save timing report...");
+    m.addItem (2, "Reset timing");
+    m.addSeparator();
+    m.addItem (3, processor.isTracing() ? "Stop trace" : "Start trace (Documents/MiniSynth-trace-*.json)");
+    m.addSeparator();
+
+    // Voices render at most at this rate; faster host rates are reached by upsampling
+    const double engineRates[] = { 0.0, 48000.0, 96000.0 };
+    PopupMenu rates;
+    for (int i = 0; i < (int) std::size (engineRates); ++i)
+        rates.addItem (10 + i, i == 0 ? String ("Host rate") : String (engineRates[i] / 1000.0) + " kHz",
+                       true, processor.getEngineRate() == engineRates[i]);
+    m.addSubMenu ("Engine rate", rates);
+
+    m.showMenuAsync (PopupMenu::Options().withTargetComponent (timingBtn), [this, engineRates] (int result) {
+        if (result >= 10 && result < 10 + (int) std::size (engineRates)) processor.setEngineRate (engineRates[result - 10]);
+        if (result == 2) processor.resetDeadlineStats();
+        if (result == 3) {
+            if (processor.isTracing()) processor.stopTrace();
+            else processor.startTrace (File::getSpecialLocation (File::userDocumentsDirectory)
+                                           .getChildFile ("MiniSynth-trace-" + Time::getCurrentTime().formatted ("%Y%m%d-%H%M%S") + ".json"));
+        }
+        if (result != 1) return;
+
+        reportChooser = std::make_unique<FileChooser> ("Save timing report", processor.getUserPresetDir().getChildFile ("MiniSynth-timing.txt"), "*.txt");
+        reportChooser->launchAsync (FileBrowserComponent::saveMode | FileBrowserComponent::canSelectFiles, [this] (const FileChooser& fc) {
+            const auto f = fc.getResult();
+            if (f != File()) processor.writeDeadlineReport (f);
+        });
+    });
+}
+
+void MiniSynthAudioProcessorEditor::showPartsMenu() {
+    PopupMenu m;
+    const int counts[] = { 1, 2, 4, 8, 16 };
+    for (int i = 0; i < (int) std::size (counts); ++i)
+        m.addItem (1 + i, i == 0 ? String ("Single part (all channels)") : String (counts[i]) + " parts (one per MIDI channel)",
+                   true, processor.getNumParts() == counts[i]);
+
+    // Part N plays channel N; part 1 is the patch being edited. Item id = 100 + part: opens the browser
+    if (processor.getNumParts() > 1) m.addSeparator();
+    for (int part = 2; part <= processor.getNumParts(); ++part)
+        m.addItem (100 + part, "Part " + String (part) + " (ch " + String (part) + "): " + processor.getPartPresetName (part) + "...");
+
+    m.showMenuAsync (PopupMenu::Options().withTargetComponent (partsBtn), [this, counts] (int result) {
+        if (result >= 1 && result <= (int) std::size (counts)) processor.setNumParts (counts[result - 1]);
+        if (result <= 100) return;
+
+        const int part = result - 100;
+        const int current = processor.getPresetNames().indexOf (processor.getPartPresetName (part));
+        PresetBrowser::show (partsBtn, *this, processor.getPresetIndex(), current, [this, part] (int idx) { processor.setPartPreset (part, idx); });
+    });
+}
+
+void MiniSynthAudioProcessorEditor::showTuningMenu() {
+    PopupMenu m;
+    const bool tuned = processor.getTuningScale() != File();
+    m.addItem (1, "Load scale (.scl)...");
+    m.addItem (2, "Load keyboard mapping (.kbm)...", tuned);
+    m.addItem (3, "12-TET", true, ! tuned);
+    if (tuned) {
+        m.addSeparator();
+        m.addItem (4, processor.getTuningName(), false);
+        m.addItem (5, processor.getTuningMapping() == File() ? String ("Default mapping") : processor.getTuningMapping().getFileName(), false);
+    }
+
+    m.showMenuAsync (PopupMenu::Options().withTargetComponent (tuningBtn), [this] (int result) {
+        if (result == 3) processor.clearTuning();
+        if (result != 1 && result != 2) return;
+
+        const bool scale = result == 1;
+        tuningChooser = std::make_unique<FileChooser> (scale ? "Load Scala scale" : "Load Scala keyboard mapping",
+                                                       scale ? processor.getTuningScale() : processor.getTuningMapping(),
+                                                       scale ? "*.scl" : "*.kbm");
+        tuningChooser->launchAsync (FileBrowserComponent::openMode | FileBrowserComponent::canSelectFiles, [this, scale] (const FileChooser& fc) {
+            const auto f = fc.getResult();
+            if (f == File()) return;
+            String error; // a new scale keeps the current mapping
+            if (! processor.loadTuning (scale ? f : processor.getTuningScale(), scale ? processor.getTuningMapping() : f, error))
+                NativeMessageBox::showMessageBoxAsync (MessageBoxIconType::WarningIcon, "Tuning", error);
+        });
+    });
+}
+
 void MiniSynthAudioProcessorEditor::timerCallback() {
-    // placeholder for meters
+    syncControls();
+    refreshTableButtons(); // a restored session may have swapped tables, an import may have finished
+    for (int i = 0; i < 3; ++i) {
+        const auto error = processor.takeWavetableError (i);
+        if (error.isNotEmpty())
+            NativeMessageBox::showMessageBoxAsync (MessageBoxIconType::WarningIcon, "Wavetable", "OSC" + String (i + 1) + ": " + error);
+    }
+    tuningBtn.setTooltip (processor.getTuningName());
+
+    const auto s = processor.getDeadlineStats();
+    const auto pct = [] (double load) { return String (100.0 * load, 1) + "%"; };
+    loadLabel.setText ("DSP " + pct (s.meanLoad) + "  p99.9 " + pct (s.p999Load) + "  max " + pct (s.worstLoad)
+                       + "  xruns " + String ((int64) s.overruns)
+                       + (processor.getEcoTier() > 0 ? "  eco: " + StringArray::fromTokens (params::ecoTierChoices, "|", "")[processor.getEcoTier()] : String()),
+                       dontSendNotification);
+    loadLabel.setColour (Label::textColourId, s.overruns > 0 ? Colours::orangered : Colours::lightgrey);
 }
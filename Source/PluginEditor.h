@@ -4,7 +4,7 @@
     Revision: 1.0.0
     Date: 2025-09-03
     Description:
-        Implements the editor: builds controls, binds APVTS attachments,
+        Implements the editor: builds controls, binds them to parameters (ParamSync),
         presets toolbar, and compact/full layouts. (Patched to remove deprecated
         AlertWindow::runModalLoop and old showOkCancelBox signature.)
 */
@@ -12,6 +12,7 @@
 #pragma once
 #include "JuceIncludes.h"
 #include "PluginProcessor.h"
+#include "ParamSync.h"
 
 class MiniSynthAudioProcessorEditor : public juce::AudioProcessorEditor, private juce::Timer {
 public:
@@ -23,10 +24,6 @@ public:
     juce::LookAndFeel* getKnobLookAndFeel() { return &knobLAF; }
 
 private:
-    using Attach  = juce::AudioProcessorValueTreeState::SliderAttachment;
-    using BAttach = juce::AudioProcessorValueTreeState::ButtonAttachment;
-    using CAttach = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
-  
     // --- Knob labels (name under rotary sliders)
     struct KnobLabelLink { juce::Slider* slider = nullptr; juce::Label* label = nullptr; };
     juce::OwnedArray<juce::Label> knobLabels;      // owns label instances
@@ -52,14 +49,35 @@ private:
     void addControlLabel(juce::Component& c, const juce::String& text);
     void positionControlLabels();
     
-    void updateVisibility();
+    void updateVisibility();   // compact/full
     // Branding (top-right logo)
     juce::ImageComponent brandImage;   // displays embedded logo
     void refreshBrandImage();          // loads from BinaryData
     MiniSynthAudioProcessor& processor;
 
-    // Presets
-    juce::ComboBox presetBox; juce::TextButton saveBtn {"Save"}, deleteBtn {"Delete"}, reloadBtn {"Reload"};
+    // Presets: the button shows the current preset and opens the browser
+    juce::TextButton presetBtn; juce::TextButton saveBtn {"Save"}, deleteBtn {"Delete"}, reloadBtn {"Reload"};
+    int currentPreset = 0;
+
+    // Morph (A/B take the current preset)
+    juce::TextButton morphABtn {"Set A"}, morphBBtn {"Set B"};
+    juce::ToggleButton morphOn {"Morph"};
+    juce::Slider morph;
+
+    // processBlock load vs. deadline (text updated by the timer); the button saves a report or resets
+    juce::Label loadLabel;
+    juce::TextButton timingBtn {"Timing"};
+    std::unique_ptr<juce::FileChooser> reportChooser;
+    void showTimingMenu();
+
+    // Multi-timbral parts: how many, and the preset each of parts 2..N plays
+    juce::TextButton partsBtn {"Parts"};
+    void showPartsMenu();
+
+    // Scala tuning: load a scale / keyboard mapping, or back to 12-TET
+    juce::TextButton tuningBtn {"Tuning"};
+    std::unique_ptr<juce::FileChooser> tuningChooser;
+    void showTuningMenu();
 
     // Compact toggle (disabled: always show full UI)
     juce::ToggleButton compactToggle {"Compact"}; bool isCompact = false;
@@ -91,18 +109,26 @@ private:
     juce::ToggleButton sync21 {"Sync 2-1"}, sync31 {"Sync 3-1"};
     juce::Slider fm31, fm32;
 
-    // Attachments
-    std::unique_ptr<CAttach> aW1, aW2, aW3, aFiltType, aSubWave, aSubOct, aLfo1T, aLfo2T;
-    std::unique_ptr<Attach> aMix1, aMix2, aMix3, aCut, aQ, aGain, aDet1, aDet2, aDet3, aSpread, aUniDet, aUniWidth;
-    std::unique_ptr<Attach> aPWM1, aPWM2, aPWM3, aPWMD1, aPWMD2, aPWMD3, aPWMR1, aPWMR2, aPWMR3;
-    std::unique_ptr<Attach> aSubLevel, aSubDrive, aNoiseW, aNoiseP, aNoiseB, aNoiseHPF, aAA, aAD, aAS, aAR, aFA, aFD, aFS, aFR, aFAmt;
-    std::unique_ptr<Attach> aLfo1Rate, aLfo1Depth, aLfo2Rate, aLfo2Depth, aFM31, aFM32;
-    std::unique_ptr<BAttach> aUniOn, aSubOn, aSubAsym, aNoiseHPFOn, aSync21, aSync31;
+    juce::ToggleButton ecoOn {"Eco"}; juce::ComboBox ecoMaxTier;
+    juce::ToggleButton freezeOn {"Freeze"};
+
+    // User wavetables: on switch, frame position and a load / clear menu per oscillator; LFO sweeps
+    juce::ToggleButton tOn1 {"Table"}, tOn2 {"Table"}, tOn3 {"Table"};
+    juce::ToggleButton lfo1Table {"> Table"}, lfo2Table {"> Table"};
+    juce::Slider tPos1, tPos2, tPos3;
+    juce::TextButton tableBtn[3];
+    std::unique_ptr<juce::FileChooser> tableChooser;
+    void showTableMenu (int osc);
+    void refreshTableButtons();
+
+    // Parameter <-> control binding, refreshed by the timer from the processor's version
+    ParamSync paramSync { processor.apvts };
+    void syncControls();
 
     // Helpers
     void layoutCompact (juce::Rectangle<int> r);
     void layoutFull    (juce::Rectangle<int> r);
-    void refreshPresetBox();
+    void refreshPresetButton();
 
     void timerCallback() override;
 
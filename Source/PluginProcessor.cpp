@@ -4,13 +4,17 @@
     Revision: 1.0.0
     Date: 2025-08-19
     Description:
-        Implements the main processor logic: audio rendering via Synthesiser,
+        Implements the main processor logic: audio rendering via VoiceManager,
         parameter layout, state save/restore, and preset manager wiring.
 */
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
-#include "dsp/SynthVoice.h"
+#include "dsp/VoiceManager.h"
+#include "dsp/PartRenderer.h"
+#include "dsp/NoteCache.h"
+#include "dsp/SharedTables.h"
+#include "diag/RealtimeCheck.h"
 #include "presets/PresetManager.h"
 
 using namespace juce;
@@ -18,13 +22,29 @@ using namespace juce;
 MiniSynthAudioProcessor::MiniSynthAudioProcessor()
 : AudioProcessor (BusesProperties().withOutput ("Output", AudioChannelSet::stereo(), true))
 {
-    synth.clearVoices();
-    for (int i = 0; i < 8; ++i)
-        synth.addVoice (new SynthVoice (apvts));
-    synth.clearSounds();
-    synth.addSound (new SynthSound());
+    for (int i = 0; i < params::count; ++i)
+        rawParams[i] = apvts.getRawParameterValue (params::specs[i].id);
+    updateParamBlock();
+
+    voices = std::make_unique<VoiceManager> (8, paramBlock);
+    voices->setUserTables (&wavetables.current());
+    voices->setTuning (&tuning);
+    parts = std::make_unique<PartRenderer> (wavetables.current(), tuning);
+    noteCache = std::make_unique<NoteCache>();
+    voices->setNoteCache (noteCache.get());
 
     presetMgr = std::make_unique<presets::PresetManager> (apvts, "YourName", "MiniSynth");
+    addListener (&paramVersion);
+    startTimerHz (10);
+}
+
+void MiniSynthAudioProcessor::timerCallback() {
+    // Reported from the message thread: notifying the host takes listener locks
+    auto* p = apvts.getParameter (ids::ecoTier);
+    const float norm = p->convertTo0to1 ((float) eco.getTier());
+    if (p->getValue() != norm) p->setValueNotifyingHost (norm);
+
+    installWavetableImports();
 }
 
 bool MiniSynthAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const {
@@ -32,17 +52,52 @@ bool MiniSynthAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts
 }
 
 void MiniSynthAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock) {
-    synth.setCurrentPlaybackSampleRate (sampleRate);
-    for (int i = 0; i < synth.getNumVoices(); ++i)
-        if (auto* v = dynamic_cast<SynthVoice*> (synth.getVoice (i)))
-            v->prepare (sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    renderChunk = requestedChunk; // voices only ever see renderChunk samples at once
+    wavetables.collect();         // audio is stopped: replaced tables can be unmapped
+    tuning.collect();
+
+    // Voices at the engine rate when the host is faster, else at the host rate
+    const bool upsampled = engineRate > 0.0 && upsampler.prepare (engineRate, sampleRate, jmax (1, samplesPerBlock), getTotalNumOutputChannels());
+    const double voiceRate = upsampled ? engineRate : sampleRate;
+    engineBuffer.setSize (getTotalNumOutputChannels(), upsampled ? upsampler.getMaxInput() : 0);
+    engineMidi.ensureSize (upsampled ? 32 * 1024 : 0);
+    setLatencySamples (upsampled ? upsampler.getLatencySamples() : 0);
+
+    updateParamBlock();
+    dspTables = SharedTables::acquire (voiceRate);
+    midiThinner.prepare (sampleRate);
+    deadline.prepare (sampleRate);
+    eco.prepare (sampleRate);
+    appliedTier = -1;
+    voices->prepare (voiceRate, renderChunk, getTotalNumOutputChannels(), *dspTables);
+    noteCache->prepare (voiceRate, renderChunk, dspTables); // after the voices let go of their renders
+    parts->prepare (voiceRate, renderChunk, jmax (samplesPerBlock, engineBuffer.getNumSamples()), getTotalNumOutputChannels(), *dspTables);
 }
 
 void MiniSynthAudioProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer& midi) {
+    const RealtimeCheck::ScopedAudioThread audioThread; // no-op unless MS_RT_CHECK
+    const DeadlineMonitor::Scope timed (deadline, buffer.getNumSamples());
+    if (TraceRecorder::isActive()) TraceRecorder::get().nameThread ("audio");
+    MS_TRACE_SCOPE ("processBlock", "audio", buffer.getNumSamples());
     ScopedNoDenormals noDenormals;
     for (int ch = 0; ch < buffer.getNumChannels(); ++ch) buffer.clear (ch, 0, buffer.getNumSamples());
 
-    synth.renderNextBlock (buffer, midi, 0, buffer.getNumSamples());
+    updateParamBlock();
+    wavetables.beginBlock();
+    tuning.beginBlock();
+    noteCache->beginBlock();
+    parts->beginBlock();
+    midiThinner.process (midi);
+
+    // Eco: quality for this block from the previous block's load. Offline renders stay at full
+    // quality so bounces do not depend on CPU load.
+    const int tier = eco.update (deadline.getLastLoad(), buffer.getNumSamples(),
+                                 paramBlock[params::idx::ecoOn] > 0.5f && ! isNonRealtime(), (int) paramBlock[params::idx::ecoMaxTier]);
+    if (tier != appliedTier) { voices->setQuality (EcoGovernor::qualityFor (tier)); parts->setQuality (EcoGovernor::qualityFor (tier)); appliedTier = tier; }
+    if (tier >= EcoGovernor::ReducedPolyphony) { voices->limitPolyphony (EcoGovernor::reducedPolyphony); parts->limitPolyphony (EcoGovernor::reducedPolyphony); }
+
+    if (upsampler.isActive()) renderVoicesUpsampled (buffer, midi);
+    else                      renderVoices (buffer, midi);
 
     float peak = 0.0f;
     for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
@@ -51,106 +106,272 @@ void MiniSynthAudioProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuff
             peak = jmax (peak, std::abs (d[i]));
     }
     meterLevel.store (0.9f * meterLevel.load() + 0.1f * peak);
+    noteCache->endBlock();
+    tuning.endBlock();
+    wavetables.endBlock();
+}
+
+// Fixed-size chunks keep each voice's working set in L1 whatever the host block
+// size; MIDI inside a chunk is applied sample-accurately as voice events.
+void MiniSynthAudioProcessor::renderVoices (AudioBuffer<float>& buffer, const MidiBuffer& midi) {
+    renderSpan (buffer, midi, 0, buffer.getNumSamples());
+}
+
+// [start, start + num) of 'out': the main patch alone, or every part in parallel
+void MiniSynthAudioProcessor::renderSpan (AudioBuffer<float>& out, const MidiBuffer& midi, int start, int num) {
+    if (parts->getNumParts() > 1) { parts->render (*voices, out, midi, start, num, renderChunk); return; }
+    for (int pos = start; pos < start + num; pos += renderChunk)
+        voices->renderNextBlock (out, midi, pos, jmin (renderChunk, start + num - pos));
+}
+
+// Host block in slices the upsampler was sized for: each slice renders just the engine
+// samples it needs, with its MIDI moved to the engine sample lined up with it. Events
+// that land before any engine sample is due wait in engineMidi for the next render.
+void MiniSynthAudioProcessor::renderVoicesUpsampled (AudioBuffer<float>& buffer, const MidiBuffer& midi) {
+    const int numSamples = buffer.getNumSamples();
+    for (int pos = 0; pos < numSamples; pos += upsampler.getMaxOutput()) {
+        const int n = jmin (upsampler.getMaxOutput(), numSamples - pos);
+        const int needed = upsampler.getInputNeeded (n);
+
+        for (auto it = midi.findNextSamplePosition (pos); it != midi.cend(); ++it) {
+            const auto meta = *it;
+            if (meta.samplePosition >= pos + n) break;
+            engineMidi.addEvent (meta.data, meta.numBytes, jlimit (0, jmax (0, needed - 1), upsampler.getInputIndexFor (meta.samplePosition - pos)));
+        }
+
+        if (needed > 0) {
+            for (int ch = 0; ch < engineBuffer.getNumChannels(); ++ch) engineBuffer.clear (ch, 0, needed);
+            renderSpan (engineBuffer, engineMidi, 0, needed);
+            engineMidi.clear();
+        }
+        upsampler.process (engineBuffer, needed, buffer, pos, n);
+    }
+}
+
+void MiniSynthAudioProcessor::setEngineRate (double hz) {
+    hz = hz > 0.0 ? jlimit (22050.0, 192000.0, hz) : 0.0;
+    if (hz == engineRate) return;
+
+    engineRate = hz;
+    if (getSampleRate() > 0.0) { // already running: rebuild voices and resampler at the new rate
+        suspendProcessing (true);
+        prepareToPlay (getSampleRate(), getBlockSize());
+        suspendProcessing (false);
+    }
+}
+
+bool MiniSynthAudioProcessor::loadWavetable (int osc, const File& wav, String& error) {
+    if (! isPositiveAndBelow (osc, UserTables::numSlots)) { error = "no oscillator " + String (osc + 1); return false; }
+    if (! wav.existsAsFile()) { error = "file not found: " + wav.getFullPathName(); return false; }
+    wavetableErrors[osc].clear();
+
+    if (auto table = WavetableLibrary::find (wav)) {
+        wavetableImporter.cancel (osc);
+        wavetables.set (osc, std::move (table));
+    } else {
+        wavetableImporter.request (osc, wav); // WAV read, FFTs and cache write stay off this thread
+    }
+    return true;
+}
+
+void MiniSynthAudioProcessor::clearWavetable (int osc) {
+    if (! isPositiveAndBelow (osc, UserTables::numSlots)) return;
+    wavetableImporter.cancel (osc);
+    wavetables.set (osc, nullptr);
+}
+
+File MiniSynthAudioProcessor::getWavetableFile (int osc) const {
+    if (! isPositiveAndBelow (osc, UserTables::numSlots)) return {};
+    const auto pending = wavetableImporter.getPending (osc);
+    if (pending != File()) return pending;
+    return wavetables.get (osc) != nullptr ? wavetables.get (osc)->getSource() : File();
+}
+
+bool MiniSynthAudioProcessor::isWavetableImporting (int osc) const {
+    return isPositiveAndBelow (osc, UserTables::numSlots) && wavetableImporter.getPending (osc) != File();
+}
+
+String MiniSynthAudioProcessor::takeWavetableError (int osc) {
+    if (! isPositiveAndBelow (osc, UserTables::numSlots)) return {};
+    auto error = wavetableErrors[osc];
+    wavetableErrors[osc].clear();
+    return error;
+}
+
+void MiniSynthAudioProcessor::installWavetableImports() {
+    for (auto& r : wavetableImporter.collect()) {
+        if (r.table != nullptr) wavetables.set (r.slot, std::move (r.table));
+        else wavetableErrors[r.slot] = r.error; // the previous table keeps playing
+    }
+}
+
+void MiniSynthAudioProcessor::finishWavetableImports() {
+    wavetableImporter.waitUntilIdle();
+    installWavetableImports();
+}
+
+bool MiniSynthAudioProcessor::loadTuning (const File& scl, const File& kbm, String& error) {
+    auto table = Scala::load (scl, kbm, error);
+    if (table == nullptr) return false;
+    tuning.set (std::move (table));
+    tuningScl = scl; tuningKbm = kbm;
+    return true;
+}
+
+void MiniSynthAudioProcessor::clearTuning() {
+    tuning.set (nullptr);
+    tuningScl = tuningKbm = File();
+}
+
+String MiniSynthAudioProcessor::getTuningName() const {
+    return tuning.get() != nullptr ? tuning.get()->name : TuningTable::equal().name;
+}
+
+int MiniSynthAudioProcessor::getNumParts() const { return parts->getNumParts(); }
+
+void MiniSynthAudioProcessor::setNumParts (int n) {
+    n = jlimit (1, PartRenderer::maxParts, n);
+    if (n == parts->getNumParts()) return;
+
+    // New parts start as a copy of the main patch
+    params::Block live;
+    for (int i = 0; i < params::count; ++i) live.values[i] = rawParams[i]->load();
+
+    suspendProcessing (true);
+    parts->setNumParts (n, live, jlimit (0, 7, SystemStats::getNumCpus() - 1));
+    voices->setChannel (n > 1 ? 1 : 0);
+    appliedTier = -1; // new parts take the current eco quality
+    suspendProcessing (false);
+
+    partPresets.removeRange (n, partPresets.size());
+    while (partPresets.size() < n) partPresets.add (partPresets.isEmpty() ? String() : "(part 1 copy)");
+}
+
+bool MiniSynthAudioProcessor::setPartPreset (int part, int presetIndex) {
+    float norm[params::count];
+    if (part < 2 || part > parts->getNumParts() || ! presetMgr || ! presetMgr->getNormalisedValues (presetIndex, norm)) return false;
+
+    params::Block values;
+    for (int i = 0; i < params::count; ++i)
+        values.values[i] = apvts.getParameter (params::specs[i].id)->convertFrom0to1 (norm[i]);
+    parts->setPartValues (part - 1, values);
+    partPresets.set (part - 1, getPresetNames()[presetIndex]);
+    return true;
+}
+
+String MiniSynthAudioProcessor::getPartPresetName (int part) const {
+    return part >= 2 && part <= parts->getNumParts() ? partPresets[part - 1] : String();
+}
+
+void MiniSynthAudioProcessor::setRenderChunkSize (int samples) {
+    requestedChunk = jlimit (16, 1024, (int) nextPowerOfTwo (samples));
+}
+
+void MiniSynthAudioProcessor::updateParamBlock() {
+    int changed = 0;
+    for (int i = 0; i < params::count; ++i) {
+        paramBlock.values[i] = rawParams[i]->load();
+        changed += paramBlock.values[i] != lastRaw[i];
+        lastRaw[i] = paramBlock.values[i];
+    }
+    if (TraceRecorder::isActive()) TraceRecorder::get().counter ("paramChanges", changed);
+
+    // Morph writes straight into the block: voices see it, the host is not notified
+    if (paramBlock[params::idx::morphOn] > 0.5f)
+        morph.process (paramBlock[params::idx::morph], paramBlock);
+}
+
+bool MiniSynthAudioProcessor::setMorphSlot (int slot, int presetIndex) {
+    float norm[params::count];
+    if (! presetMgr || ! presetMgr->getNormalisedValues (presetIndex, norm)) return false;
+
+    morph.setSlot (slot == 0 ? presets::PresetMorph::A : presets::PresetMorph::B, norm);
+    apvts.state.setProperty (slot == 0 ? "morphA" : "morphB", getPresetNames()[presetIndex], nullptr);
+    return true;
+}
+
+void MiniSynthAudioProcessor::restoreMorphSlots() {
+    const auto names = getPresetNames();
+    for (int slot = 0; slot < 2; ++slot) {
+        const int index = names.indexOf (apvts.state.getProperty (slot == 0 ? "morphA" : "morphB").toString());
+        if (index >= 0) setMorphSlot (slot, index);
+    }
 }
 
 void MiniSynthAudioProcessor::getStateInformation (MemoryBlock& dest) {
     auto tree = apvts.copyState();
+    tree.setProperty ("engineRate", engineRate, nullptr); // session settings, not part of presets
+    for (int i = 0; i < UserTables::numSlots; ++i)
+        tree.setProperty ("wavetable" + String (i + 1), getWavetableFile (i).getFullPathName(), nullptr);
+    tree.setProperty ("tuningScl", tuningScl.getFullPathName(), nullptr);
+    tree.setProperty ("tuningKbm", tuningKbm.getFullPathName(), nullptr);
+    tree.setProperty ("parts", getNumParts(), nullptr);
+    for (int part = 2; part <= getNumParts(); ++part)
+        tree.setProperty ("part" + String (part), getPartPresetName (part), nullptr);
     if (auto xml = tree.createXml()) copyXmlToBinary (*xml, dest);
 }
 
 void MiniSynthAudioProcessor::setStateInformation (const void* data, int size) {
-    if (auto xml = getXmlFromBinary (data, size)) apvts.replaceState (ValueTree::fromXml (*xml));
+    if (auto xml = getXmlFromBinary (data, size)) {
+        apvts.replaceState (ValueTree::fromXml (*xml));
+        restoreMorphSlots();
+        setEngineRate ((double) apvts.state.getProperty ("engineRate", 0.0));
+        for (int i = 0; i < UserTables::numSlots; ++i) {
+            const auto path = apvts.state.getProperty ("wavetable" + String (i + 1)).toString();
+            String error;
+            if (path.isEmpty() || getWavetableFile (i) != File (path)) clearWavetable (i); // no stale table while importing
+            if (path.isEmpty() || ! loadWavetable (i, File (path), error)) clearWavetable (i); // missing file: the oscillator plays its wave
+        }
+        const auto scl = apvts.state.getProperty ("tuningScl").toString(), kbm = apvts.state.getProperty ("tuningKbm").toString();
+        String error;
+        if (scl.isEmpty() || ! loadTuning (File (scl), kbm.isEmpty() ? File() : File (kbm), error)) clearTuning(); // missing files: 12-TET
+        setNumParts ((int) apvts.state.getProperty ("parts", 1));
+        const auto names = getPresetNames();
+        for (int part = 2; part <= getNumParts(); ++part) {
+            const int index = names.indexOf (apvts.state.getProperty ("part" + String (part)).toString());
+            if (index >= 0) setPartPreset (part, index);
+        }
+    }
+}
+
+namespace {
+// Read-only choice the processor writes; hosts show it as a meter / output lane
+struct OutputChoice : AudioParameterChoice {
+    using AudioParameterChoice::AudioParameterChoice;
+    bool isAutomatable() const override { return false; }
+    Category getCategory() const override { return genericMeter; }
+};
 }
 
 AudioProcessorValueTreeState::ParameterLayout MiniSynthAudioProcessor::createLayout() {
-    using AP = AudioProcessorValueTreeState;
     std::vector<std::unique_ptr<RangedAudioParameter>> p;
 
-    // Waves
-    p.push_back (std::make_unique<AudioParameterChoice> (ids::osc1Wave, "OSC1", StringArray{ "Sine","Saw+","Pulse","Tri","NoiseW","Saw-","Fold","HalfS" }, 1));
-    p.push_back (std::make_unique<AudioParameterChoice> (ids::osc2Wave, "OSC2", StringArray{ "Sine","Saw+","Pulse","Tri","NoiseW","Saw-","Fold","HalfS" }, 2));
-    p.push_back (std::make_unique<AudioParameterChoice> (ids::osc3Wave, "OSC3", StringArray{ "Sine","Saw+","Pulse","Tri","NoiseW","Saw-","Fold","HalfS" }, 0));
-
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::mix1, "Mix1", NormalisableRange<float> (0,1), 0.7f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::mix2, "Mix2", NormalisableRange<float> (0,1), 0.6f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::mix3, "Mix3", NormalisableRange<float> (0,1), 0.2f));
-
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::detune1, "Det1 (st)", NormalisableRange<float> (-24, 24), 0.0f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::detune2, "Det2 (st)", NormalisableRange<float> (-24, 24), 0.0f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::detune3, "Det3 (st)", NormalisableRange<float> (-24, 24), 0.0f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::stereoSpread, "Spread", NormalisableRange<float> (0, 1), 0.2f));
-
-    p.push_back (std::make_unique<AudioParameterBool>  (ids::uniOn,  "Unison", true));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::uniDetune, "UniDet", NormalisableRange<float> (0, 50), 12.0f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::uniWidth,  "UniWidth", NormalisableRange<float> (0, 1), 0.5f));
-
-    // PWM
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::pwm1, "PWM1", NormalisableRange<float> (0.05f, 0.95f), 0.5f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::pwm2, "PWM2", NormalisableRange<float> (0.05f, 0.95f), 0.5f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::pwm3, "PWM3", NormalisableRange<float> (0.05f, 0.95f), 0.5f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::pwmDepth1, "PWM1 Depth", NormalisableRange<float> (0,1), 0.3f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::pwmDepth2, "PWM2 Depth", NormalisableRange<float> (0,1), 0.3f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::pwmDepth3, "PWM3 Depth", NormalisableRange<float> (0,1), 0.3f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::pwmRate1,  "PWM1 Rate",  NormalisableRange<float> (0.05f, 10.0f, 0.f, 0.4f), 1.2f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::pwmRate2,  "PWM2 Rate",  NormalisableRange<float> (0.05f, 10.0f, 0.f, 0.4f), 0.8f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::pwmRate3,  "PWM3 Rate",  NormalisableRange<float> (0.05f, 10.0f, 0.f, 0.4f), 0.6f));
-
-    // Sub & Noise
-    p.push_back (std::make_unique<AudioParameterBool>  (ids::subOn, "Sub On", true));
-    p.push_back (std::make_unique<AudioParameterChoice>(ids::subWave, "Sub Wave", StringArray{ "Sine","Square","Tri" }, 1));
-    p.push_back (std::make_unique<AudioParameterChoice>(ids::subOct,  "Sub Oct",  StringArray{ "-1","-2" }, 1));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::subLevel,"Sub Level", NormalisableRange<float> (0,1), 0.35f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::subDrive,"Sub Drive", NormalisableRange<float> (0,24), 6.0f));
-    p.push_back (std::make_unique<AudioParameterBool>  (ids::subAsym, "Sub Asym", false));
-
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::mixNoiseW, "White", NormalisableRange<float> (0,1), 0.0f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::mixNoiseP, "Pink",  NormalisableRange<float> (0,1), 0.0f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::mixNoiseB, "Brown", NormalisableRange<float> (0,1), 0.0f));
-    p.push_back (std::make_unique<AudioParameterBool>  (ids::noiseHPFOn, "Noise HPF", false));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::noiseHPF,   "HPF Hz",     NormalisableRange<float> (20.0f, 2000.0f, 0.f, 0.4f), 120.0f));
-
-    // Amp ADSR
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::attack,  "Attack",  NormalisableRange<float> (0.001f, 3.0f, 0.f, 0.5f), 0.01f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::decay,   "Decay",   NormalisableRange<float> (0.001f, 3.0f, 0.f, 0.5f), 0.12f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::sustain, "Sustain", NormalisableRange<float> (0.0f,   1.0f), 0.8f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::release, "Release", NormalisableRange<float> (0.001f, 4.0f, 0.f, 0.5f), 0.25f));
-
-    // Filter + Env
-    p.push_back (std::make_unique<AudioParameterChoice>(ids::filterType, "Filter", StringArray{ "LP","BP","HP" }, 0));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::cutoff, "Cutoff", NormalisableRange<float> (20.0f, 20000.0f, 0.f, 0.3f), 12000.0f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::resonance, "Q", NormalisableRange<float> (0.1f, 10.0f, 0.f, 0.5f), 0.7f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::fA, "F-Attack",  NormalisableRange<float> (0.001f, 3.0f, 0.f, 0.5f), 0.01f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::fD, "F-Decay",   NormalisableRange<float> (0.001f, 3.0f, 0.f, 0.5f), 0.12f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::fS, "F-Sustain", NormalisableRange<float> (0.0f,   1.0f), 0.0f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::fR, "F-Release", NormalisableRange<float> (0.001f, 4.0f, 0.f, 0.5f), 0.25f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::fAmt, "F-Amount", NormalisableRange<float> (0.0f,  1.0f), 0.0f));
-
-    // LFOs
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::lfoRate,  "LFO1 Rate",  NormalisableRange<float> (0.05f, 20.0f, 0.f, 0.5f), 5.0f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::lfoDepth, "LFO1 Depth", NormalisableRange<float> (0.0f,   1.0f), 0.3f));
-    p.push_back (std::make_unique<AudioParameterChoice>(ids::lfoTarget,"LFO1 Target", StringArray{ "None","Pitch","Amp","Cutoff","PWM" }, 0));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::lfo2Rate,  "LFO2 Rate",  NormalisableRange<float> (0.05f, 20.0f, 0.f, 0.5f), 0.8f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::lfo2Depth, "LFO2 Depth", NormalisableRange<float> (0.0f,   1.0f), 0.2f));
-    p.push_back (std::make_unique<AudioParameterChoice>(ids::lfo2Target,"LFO2 Target", StringArray{ "None","Pitch","Amp","Cutoff","PWM" }, 0));
-
-    // Sync / FM (reserved)
-    p.push_back (std::make_unique<AudioParameterBool>  (ids::sync2to1, "Sync 2-1", false));
-    p.push_back (std::make_unique<AudioParameterBool>  (ids::sync3to1, "Sync 3-1", false));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::fm31, "FM 3-1 (st)", NormalisableRange<float> (0.0f, 24.0f), 0.0f));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::fm32, "FM 3-2 (st)", NormalisableRange<float> (0.0f, 24.0f), 0.0f));
-
-    // Global
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::gain, "Gain", NormalisableRange<float> (-24.0f, 6.0f), -6.0f));
-    p.push_back (std::make_unique<AudioParameterBool>  (ids::mpeEnabled, "MPE", true));
-    p.push_back (std::make_unique<AudioParameterFloat> (ids::bendRange,  "Bend", NormalisableRange<float> (1.0f, 48.0f), 48.0f));
+    // Ranges/defaults live in ParameterSpecs.h (shared with the preset compiler)
+    for (const auto& s : params::specs) {
+        switch (s.kind) {
+            case params::Kind::Float:
+                p.push_back (std::make_unique<AudioParameterFloat> (s.id, s.name, NormalisableRange<float> (s.start, s.end, s.interval, s.skew), s.def)); break;
+            case params::Kind::Bool:
+                p.push_back (std::make_unique<AudioParameterBool> (s.id, s.name, s.def > 0.5f)); break;
+            case params::Kind::Choice:
+                if (s.output) p.push_back (std::make_unique<OutputChoice> (s.id, s.name, StringArray::fromTokens (s.choices, "|", ""), (int) s.def));
+                else          p.push_back (std::make_unique<AudioParameterChoice> (s.id, s.name, StringArray::fromTokens (s.choices, "|", ""), (int) s.def));
+                break;
+        }
+    }
 
     return { p.begin(), p.end() };
 }
 
+void MiniSynthAudioProcessor::setNoiseSeed (juce::int64 seed) { voices->setNoiseSeed (seed); parts->setNoiseSeed (seed); }
+uint64 MiniSynthAudioProcessor::getVoiceEventsDropped() const { return voices->getEventsDropped() + parts->getEventsDropped(); }
+
 // Presets pass-through
 juce::StringArray MiniSynthAudioProcessor::getPresetNames() const { return presetMgr ? presetMgr->getAllPresetNames() : juce::StringArray(); }
+const presets::PresetIndex& MiniSynthAudioProcessor::getPresetIndex() const { return presetMgr->getIndex(); }
 bool MiniSynthAudioProcessor::isFactoryPreset (int index) const { return presetMgr && presetMgr->isFactoryIndex (index); }
 void MiniSynthAudioProcessor::applyPresetByIndex (int index) { if (presetMgr) presetMgr->applyPresetByIndex (index); }
+bool MiniSynthAudioProcessor::applyPresetFile (const juce::File& file) { return presetMgr && presetMgr->applyFile (file); }
 bool MiniSynthAudioProcessor::saveUserPreset (const juce::String& name) { return presetMgr && presetMgr->saveUserPreset (name); }
 bool MiniSynthAudioProcessor::deleteUserPreset (const juce::String& name) { return presetMgr && presetMgr->deleteUserPreset (name); }
 juce::File MiniSynthAudioProcessor::getUserPresetDir() const { return presetMgr ? presetMgr->getUserDir() : juce::File(); }
@@ -4,56 +4,39 @@
     Revision: 1.0.0
     Date: 2025-08-19
     Description:
-        Main AudioProcessor declaration. Owns the Synthesiser, APVTS parameter
+        Main AudioProcessor declaration. Owns the voice manager, APVTS parameter
         tree, preset manager façade, and exposes plugin lifecycle methods.
 */
 
 #pragma once
 #include "JuceIncludes.h"
+#include "ParameterSpecs.h"
+#include "presets/PresetMorph.h"
+#include "dsp/MidiThinner.h"
+#include "dsp/EcoGovernor.h"
+#include "dsp/PolyphaseUpsampler.h"
+#include "dsp/Wavetable.h"
+#include "dsp/Tuning.h"
+#include "diag/DeadlineMonitor.h"
+#include "diag/TraceRecorder.h"
 #include <atomic>
 
-namespace presets { class PresetManager; }
-
-namespace ids {
-// Oscillateurs & Mix
-static constexpr auto osc1Wave = "osc1Wave";
-static constexpr auto osc2Wave = "osc2Wave";
-static constexpr auto osc3Wave = "osc3Wave";
-static constexpr auto mix1 = "mix1"; static constexpr auto mix2 = "mix2"; static constexpr auto mix3 = "mix3";
-// Detune / Stereo / Unison
-static constexpr auto detune1 = "detune1"; static constexpr auto detune2 = "detune2"; static constexpr auto detune3 = "detune3";
-static constexpr auto stereoSpread = "stereoSpread";
-static constexpr auto uniOn = "uniOn"; static constexpr auto uniDetune = "uniDetune"; static constexpr auto uniWidth = "uniWidth";
-// PWM
-static constexpr auto pwm1 = "pwm1"; static constexpr auto pwm2 = "pwm2"; static constexpr auto pwm3 = "pwm3";
-static constexpr auto pwmDepth1 = "pwmDepth1"; static constexpr auto pwmDepth2 = "pwmDepth2"; static constexpr auto pwmDepth3 = "pwmDepth3";
-static constexpr auto pwmRate1  = "pwmRate1";  static constexpr auto pwmRate2  = "pwmRate2";  static constexpr auto pwmRate3  = "pwmRate3";
-// Sub & Noise
-static constexpr auto subOn = "subOn"; static constexpr auto subWave = "subWave"; static constexpr auto subOct = "subOct";
-static constexpr auto subLevel = "subLevel"; static constexpr auto subDrive = "subDrive"; static constexpr auto subAsym = "subAsym";
-static constexpr auto mixNoiseW = "mixNoiseW"; static constexpr auto mixNoiseP = "mixNoiseP"; static constexpr auto mixNoiseB = "mixNoiseB";
-static constexpr auto noiseHPFOn = "noiseHPFOn"; static constexpr auto noiseHPF = "noiseHPF";
-// Amp ADSR
-static constexpr auto attack = "attack"; static constexpr auto decay = "decay"; static constexpr auto sustain = "sustain"; static constexpr auto release = "release";
-// Filter + Env
-static constexpr auto filterType = "filterType"; static constexpr auto cutoff = "cutoff"; static constexpr auto resonance = "resonance";
-static constexpr auto fA = "fAttack"; static constexpr auto fD = "fDecay"; static constexpr auto fS = "fSustain"; static constexpr auto fR = "fRelease"; static constexpr auto fAmt = "fAmount";
-// LFOs
-static constexpr auto lfoRate = "lfoRate"; static constexpr auto lfoDepth = "lfoDepth"; static constexpr auto lfoTarget = "lfoTarget";
-static constexpr auto lfo2Rate = "lfo2Rate"; static constexpr auto lfo2Depth = "lfo2Depth"; static constexpr auto lfo2Target = "lfo2Target";
-// Sync / FM (reserved)
-static constexpr auto sync2to1 = "sync2to1"; static constexpr auto sync3to1 = "sync3to1"; static constexpr auto fm31 = "fm31"; static constexpr auto fm32 = "fm32";
-// Global
-static constexpr auto gain = "gain"; static constexpr auto mpeEnabled = "mpeEnabled"; static constexpr auto bendRange = "bendRange";
-}
-
-struct SynthSound : public juce::SynthesiserSound { bool appliesToNote (int) override { return true; } bool appliesToChannel (int) override { return true; } };
-class SynthVoice; // fwd
-
-class MiniSynthAudioProcessor : public juce::AudioProcessor {
+namespace presets { class PresetManager; class PresetIndex; }
+
+// Internal render granularity in samples (CMake: MINISYNTH_RENDER_CHUNK)
+#ifndef MS_RENDER_CHUNK
+ #define MS_RENDER_CHUNK 64
+#endif
+
+class VoiceManager; // fwd
+class PartRenderer; // fwd
+class NoteCache; // fwd
+struct DspTables; // fwd
+
+class MiniSynthAudioProcessor : public juce::AudioProcessor, private juce::Timer {
 public:
     MiniSynthAudioProcessor();
-    ~MiniSynthAudioProcessor() override = default;
+    ~MiniSynthAudioProcessor() override { stopTimer(); removeListener (&paramVersion); }
 
     // AudioProcessor
     void prepareToPlay (double, int) override;
@@ -84,19 +67,139 @@ public:
 
     // Presets API (via PresetManager)
     juce::StringArray getPresetNames() const;
+    const presets::PresetIndex& getPresetIndex() const; // search over getPresetNames() indices
     bool isFactoryPreset (int index) const;
     void applyPresetByIndex (int index);
+    bool applyPresetFile (const juce::File& file);
     bool saveUserPreset (const juce::String& name);
     bool deleteUserPreset (const juce::String& name);
     juce::File getUserPresetDir() const;
 
+    // A/B morph (slot 0 = A, 1 = B); blended per block when morphOn is set
+    bool setMorphSlot (int slot, int presetIndex);
+    bool isMorphReady() const { return morph.isReady(); }
+
     float getMeterLevel() const { return meterLevel.load(); }
 
+    // Bumped by every parameter change, whatever its source (editor, host automation,
+    // preset load); the editor polls it and skips its refresh while it stays put
+    juce::uint32 getParamVersion() const { return paramVersion.count.load (std::memory_order_acquire); }
+
+    // processBlock duration vs. its deadline (histogram, p99.9, worst, overruns);
+    // cleared by prepareToPlay and resetDeadlineStats
+    DeadlineMonitor::Stats getDeadlineStats() const { return deadline.getStats(); }
+    void resetDeadlineStats() { deadline.reset(); }
+    bool writeDeadlineReport (const juce::File& file) const { return deadline.writeReport (file); }
+
+    // Eco mode (ecoOn / ecoMaxTier parameters): tier currently rendered, 0 = full quality
+    int getEcoTier() const { return eco.getTier(); }
+    void setEcoThresholds (const EcoGovernor::Thresholds& t) { eco.setThresholds (t); }
+
+    // Chrome/Perfetto trace of blocks, voices, MIDI, preset swaps and parameter changes
+    // (process-wide: every instance writes into the same trace)
+    bool startTrace (const juce::File& file) { return TraceRecorder::get().start (file); }
+    void stopTrace() { TraceRecorder::get().stop(); }
+    bool isTracing() const { return TraceRecorder::isActive(); }
+
+    // Offline hosts only (no audio thread running): the values the voices would see
+    // next block, A/B morph included
+    params::Block getParamSnapshot() { updateParamBlock(); return paramBlock; }
+    // Offline hosts only: fixed noise seeds so renders are repeatable (default is time-based)
+    void setNoiseSeed (juce::int64 seed);
+
+    // Incoming continuous controllers are coalesced per channel/controller within
+    // this window before voice dispatch (0 = off)
+    void setMidiThinWindowMs (float ms) { midiThinner.setWindowMs (ms); }
+    juce::uint64 getMidiEventsMerged() const  { return midiThinner.getNumMerged(); }
+    juce::uint64 getMidiEventsDropped() const { return midiThinner.getNumDropped(); }
+    // Voice events lost to a full per-voice queue, all parts (a MIDI flood beyond any chunk)
+    juce::uint64 getVoiceEventsDropped() const;
+
+    // Host blocks of any size are rendered in chunks of this many samples (power of
+    // two, 16..1024). A new size takes effect at the next prepareToPlay.
+    void setRenderChunkSize (int samples);
+    int getRenderChunkSize() const { return renderChunk; }
+
+    // Voice engine rate in Hz (0 = always the host rate). When the host runs faster, the
+    // voices render at this rate and a polyphase FIR upsamples to the host rate; its delay
+    // is reported with setLatencySamples. Saved with the state; message thread.
+    void setEngineRate (double hz);
+    double getEngineRate() const { return engineRate; }
+    bool isEngineRateActive() const { return upsampler.isActive(); }
+
+    // User wavetables behind the Table switches, one per oscillator (0..2). A WAV is preprocessed
+    // into the shared cache on first use, then memory-mapped; voices pick the new table up
+    // at the next block. Paths are saved with the state; message thread.
+    // A cached file is installed straight away. Otherwise the cache is built in the background
+    // and the timer installs it; the previous table plays until then, and a failure is kept
+    // for takeWavetableError(). getWavetableFile() reports the file being imported.
+    bool loadWavetable (int osc, const juce::File& wav, juce::String& error);
+    void clearWavetable (int osc);
+    juce::File getWavetableFile (int osc) const;
+    bool isWavetableImporting (int osc) const;
+    juce::String takeWavetableError (int osc); // last background import failure, then cleared
+    void finishWavetableImports();             // offline: wait for imports and install them
+
+    // Multi-timbral mode: 2..16 parts, part N playing MIDI channel N (1 = off: every channel
+    // plays the main patch). Part 1 is the main, automatable patch; parts 2..16 each play a
+    // preset of their own. Parts render in parallel and are summed in part order. Saved with
+    // the state; message thread.
+    void setNumParts (int numParts);
+    int getNumParts() const;
+    bool setPartPreset (int part, int presetIndex); // part 2..getNumParts()
+    juce::String getPartPresetName (int part) const;
+
+    // Microtuning from a Scala scale and optional keyboard mapping (File() = default mapping).
+    // Takes effect from the next note-on; saved with the state. Message thread.
+    bool loadTuning (const juce::File& scl, const juce::File& kbm, juce::String& error);
+    void clearTuning(); // back to 12-TET
+    juce::File getTuningScale() const { return tuningScl; }
+    juce::File getTuningMapping() const { return tuningKbm; }
+    juce::String getTuningName() const;
+
 private:
+    void updateParamBlock();
+    void restoreMorphSlots();
+
     std::unique_ptr<presets::PresetManager> presetMgr;
-    juce::Synthesiser synth;
+    std::atomic<float>* rawParams[params::count] {};
+    params::Block paramBlock;            // values the voices read this block
+    float lastRaw[params::count] {};     // previous block's raw values, for the trace's change counter
+    presets::PresetMorph morph;
+    std::shared_ptr<const DspTables> dspTables; // shared by all instances at this rate
+    std::unique_ptr<VoiceManager> voices;
+    MidiThinner midiThinner;
+    DeadlineMonitor deadline;
+    EcoGovernor eco;
+    int appliedTier = -1;                // quality last pushed to the voices
+    void timerCallback() override;       // eco tier -> its read-only parameter; finished wavetable imports
+    void installWavetableImports();
     std::atomic<float> meterLevel { 0.0f };
 
+    // One processor listener for all parameters; any thread, so it only counts
+    struct ParamVersion : juce::AudioProcessorListener {
+        std::atomic<juce::uint32> count { 0 };
+        void audioProcessorParameterChanged (juce::AudioProcessor*, int, float) override { count.fetch_add (1, std::memory_order_release); }
+        void audioProcessorChanged (juce::AudioProcessor*, const ChangeDetails&) override {}
+    } paramVersion;
+    int renderChunk = MS_RENDER_CHUNK, requestedChunk = MS_RENDER_CHUNK;
+
+    void renderVoices (juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midi);
+    void renderSpan (juce::AudioBuffer<float>& out, const juce::MidiBuffer& midi, int start, int num);
+    void renderVoicesUpsampled (juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midi);
+    double engineRate = 0.0;
+    PolyphaseUpsampler upsampler;        // engine rate -> host rate, when active
+    WavetableSlots wavetables;
+    WavetableImporter wavetableImporter;  // cache builds off the message thread
+    juce::String wavetableErrors[UserTables::numSlots];
+    TuningSlot tuning;
+    juce::File tuningScl, tuningKbm;
+    std::unique_ptr<PartRenderer> parts; // multi-timbral parts 2..16
+    juce::StringArray partPresets;       // preset name per part, index = part - 1
+    std::unique_ptr<NoteCache> noteCache; // freeze mode: stored renders for the main voices
+    juce::AudioBuffer<float> engineBuffer; // voice output at the engine rate
+    juce::MidiBuffer engineMidi;         // MIDI moved onto the engine timeline
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MiniSynthAudioProcessor)
 };
 
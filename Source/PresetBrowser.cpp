@@ -0,0 +1,105 @@
+/*
+    File: PresetBrowser.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Preset browser: query on each keystroke, row painting and picking.
+*/
+
+#include "PresetBrowser.h"
+#include <algorithm>
+
+using namespace juce;
+
+PresetBrowser::PresetBrowser (const presets::PresetIndex& i, int selected, std::function<void (int)> pickFn)
+: index (i), selectedPreset (selected), onPick (std::move (pickFn))
+{
+    addAndMakeVisible (search);
+    search.setTextToShowWhenEmpty ("Search name, tag, author... (tag:, author:, cat:)", Colours::grey);
+    search.onTextChange = [this] { runQuery(); };
+    search.onReturnKey  = [this] { pick (jmax (0, list.getSelectedRow())); };
+    search.onEscapeKey  = [this] { close(); };
+
+    addAndMakeVisible (status);
+    status.setFont (status.getFont().withHeight (12.0f));
+    status.setColour (Label::textColourId, Colours::grey);
+
+    addAndMakeVisible (list);
+    list.setRowHeight (22);
+
+    runQuery();
+    // Tags of user presets may still be loading: requery when they are in
+    if (! index.isComplete()) startTimer (250);
+}
+
+void PresetBrowser::show (Component& target, Component& parent, const presets::PresetIndex& index,
+                          int selected, std::function<void (int)> onPick) {
+    auto b = std::make_unique<PresetBrowser> (index, selected, std::move (onPick));
+    b->setSize (380, 440);
+    auto* browser = b.get();
+    CallOutBox::launchAsynchronously (std::move (b), parent.getLocalArea (&target, target.getLocalBounds()), &parent);
+    browser->search.grabKeyboardFocus();
+}
+
+void PresetBrowser::resized() {
+    auto r = getLocalBounds();
+    search.setBounds (r.removeFromTop (26).reduced (2));
+    status.setBounds (r.removeFromBottom (18));
+    list.setBounds (r.reduced (2));
+}
+
+void PresetBrowser::timerCallback() {
+    if (! index.isComplete()) return;
+    stopTimer();
+    runQuery();
+}
+
+void PresetBrowser::runQuery() {
+    const auto t0 = Time::getHighResolutionTicks();
+    results = index.search (search.getText());
+    const auto ms = 1000.0 * Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - t0);
+
+    list.updateContent();
+    const auto it = std::find (results.begin(), results.end(), selectedPreset);
+    if (search.isEmpty() && it != results.end()) {
+        const int row = (int) (it - results.begin());
+        list.selectRow (row, true);
+        list.scrollToEnsureRowIsOnscreen (row);
+    } else {
+        list.selectRow (0, true);
+    }
+
+    status.setText (String ((int) results.size()) + " of " + String (index.size()) + " presets, " + String (ms, 2) + " ms"
+                    + (index.isComplete() ? String() : String ("  (indexing tags...)")), dontSendNotification);
+}
+
+void PresetBrowser::paintListBoxItem (int row, Graphics& g, int width, int height, bool rowIsSelected) {
+    if (! isPositiveAndBelow (row, (int) results.size())) return;
+    const auto info = index.getInfo (results[(size_t) row]);
+
+    if (rowIsSelected) g.fillAll (Colours::darkslategrey);
+    auto r = Rectangle<int> (0, 0, width, height).reduced (6, 0);
+
+    // Category and tags on the right, the name gets the rest
+    auto detail = info.category;
+    if (info.tags.size() > 0) detail << (detail.isEmpty() ? "" : "  ") << info.tags.joinIntoString (", ");
+    g.setFont ((float) height * 0.55f);
+    g.setColour (Colours::grey);
+    g.drawText (detail, r.removeFromRight (width / 2), Justification::centredRight, true);
+
+    g.setFont ((float) height * 0.65f);
+    g.setColour (results[(size_t) row] == selectedPreset ? Colours::orange : Colours::white);
+    g.drawText (info.name, r, Justification::centredLeft, true);
+}
+
+void PresetBrowser::pick (int row) {
+    if (! isPositiveAndBelow (row, (int) results.size())) return;
+    const int preset = results[(size_t) row];
+    if (onPick) onPick (preset);
+    close();
+}
+
+void PresetBrowser::close() {
+    if (auto* box = findParentComponentOfClass<CallOutBox>()) box->dismiss();
+}
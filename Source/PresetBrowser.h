@@ -0,0 +1,51 @@
+/*
+    File: PresetBrowser.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Preset browser shown in a call-out: a search field over the preset
+        index and a ListBox of the results. Rows are painted on demand by
+        the list model, so only the visible ones cost anything, whatever the
+        library size. Results refresh once the background meta indexing ends.
+*/
+
+#pragma once
+#include "JuceIncludes.h"
+#include "presets/PresetIndex.h"
+#include <functional>
+#include <vector>
+
+class PresetBrowser : public juce::Component, private juce::ListBoxModel, private juce::Timer {
+public:
+    // 'selected' starts highlighted; onPick gets the chosen preset index, then the call-out closes
+    PresetBrowser (const presets::PresetIndex& index, int selected, std::function<void (int)> onPick);
+
+    // Opens a browser in a call-out inside 'parent', pointing at 'target'
+    static void show (juce::Component& target, juce::Component& parent, const presets::PresetIndex& index,
+                      int selected, std::function<void (int)> onPick);
+
+    void resized() override;
+
+private:
+    int getNumRows() override { return (int) results.size(); }
+    void paintListBoxItem (int row, juce::Graphics& g, int width, int height, bool rowIsSelected) override;
+    void listBoxItemClicked (int row, const juce::MouseEvent&) override { pick (row); }
+    void returnKeyPressed (int row) override { pick (row); }
+    void timerCallback() override;
+
+    void runQuery();
+    void pick (int row);
+    void close();
+
+    const presets::PresetIndex& index;
+    const int selectedPreset;
+    std::function<void (int)> onPick;
+
+    juce::TextEditor search;
+    juce::Label status;
+    juce::ListBox list { {}, this };
+    std::vector<int> results;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetBrowser)
+};
@@ -0,0 +1,92 @@
+/*
+    File: DeadlineMonitor.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Recording (single writer, relaxed atomics, no allocation) and the
+        reader-side percentile and report code.
+*/
+
+#include "DeadlineMonitor.h"
+
+using namespace juce;
+
+void DeadlineMonitor::prepare (double sr) {
+    sampleRate = sr;
+    clear();
+    resetRequested.store (false);
+}
+
+void DeadlineMonitor::clear() noexcept {
+    for (auto& b : bins) b.store (0, std::memory_order_relaxed);
+    overruns.store (0, std::memory_order_relaxed);
+    busySeconds.store (0.0, std::memory_order_relaxed); budgetSeconds.store (0.0, std::memory_order_relaxed);
+    worstLoad.store (0.0f, std::memory_order_relaxed); worstMicros.store (0.0f, std::memory_order_relaxed);
+    lastLoad.store (0.0f, std::memory_order_relaxed);
+}
+
+void DeadlineMonitor::record (int64 startTicks, int64 endTicks, int numSamples) noexcept {
+    if (numSamples <= 0) return;
+    if (resetRequested.exchange (false, std::memory_order_acquire)) clear();
+
+    const double seconds = (double) (endTicks - startTicks) * ticksToSeconds;
+    const double budget = numSamples / sampleRate;
+    const double load = seconds / budget;
+    lastLoad.store ((float) load, std::memory_order_relaxed);
+
+    const int bin = jmin (numBins - 1, (int) (load * binsPerUnit));
+    bins[bin].store (bins[bin].load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (load > 1.0) overruns.store (overruns.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    busySeconds.store (busySeconds.load (std::memory_order_relaxed) + seconds, std::memory_order_relaxed);
+    budgetSeconds.store (budgetSeconds.load (std::memory_order_relaxed) + budget, std::memory_order_relaxed);
+    if ((float) load > worstLoad.load (std::memory_order_relaxed)) worstLoad.store ((float) load, std::memory_order_relaxed);
+    if ((float) (seconds * 1.0e6) > worstMicros.load (std::memory_order_relaxed)) worstMicros.store ((float) (seconds * 1.0e6), std::memory_order_relaxed);
+}
+
+DeadlineMonitor::Stats DeadlineMonitor::getStats() const {
+    uint32 counts[numBins];
+    uint64 total = 0;
+    for (int i = 0; i < numBins; ++i) total += (counts[i] = bins[i].load (std::memory_order_relaxed));
+
+    Stats s;
+    s.blocks = total;
+    s.overruns = overruns.load (std::memory_order_relaxed);
+    s.worstLoad = worstLoad.load (std::memory_order_relaxed);
+    s.worstMicros = worstMicros.load (std::memory_order_relaxed);
+    const double budget = budgetSeconds.load (std::memory_order_relaxed);
+    s.meanLoad = budget > 0.0 ? busySeconds.load (std::memory_order_relaxed) / budget : 0.0;
+
+    // Upper edge of the bin holding the quantile: never under-reports
+    auto quantile = [&] (double q) {
+        const auto rank = (uint64) std::ceil (q * (double) total);
+        uint64 seen = 0;
+        for (int i = 0; i < numBins; ++i)
+            if ((seen += counts[i]) >= rank) return jmin (s.worstLoad, (i + 1) / (double) binsPerUnit);
+        return s.worstLoad;
+    };
+    if (total > 0) { s.p99Load = quantile (0.99); s.p999Load = quantile (0.999); }
+    return s;
+}
+
+String DeadlineMonitor::getReport() const {
+    const auto s = getStats();
+    String r;
+    r << "MiniSynth processBlock timing, " << Time::getCurrentTime().toISO8601 (true) << newLine
+      << "sample rate " << sampleRate << " Hz" << newLine
+      << "blocks " << (int64) s.blocks << ", overruns " << (int64) s.overruns << newLine
+      << "load (% of deadline): mean " << String (100.0 * s.meanLoad, 1)
+      << ", p99 " << String (100.0 * s.p99Load, 1) << ", p99.9 " << String (100.0 * s.p999Load, 1)
+      << ", worst " << String (100.0 * s.worstLoad, 1) << " (" << String (s.worstMicros, 1) << " us)" << newLine << newLine
+      << "load % (bin start)\tblocks" << newLine;
+
+    for (int i = 0; i < numBins; ++i)
+        if (const auto c = bins[i].load (std::memory_order_relaxed))
+            r << String (100.0 * i / binsPerUnit, 2) << "\t" << (int64) c << newLine;
+    return r;
+}
+
+bool DeadlineMonitor::writeReport (const File& file) const {
+    return file.replaceWithText (getReport());
+}
@@ -0,0 +1,56 @@
+/*
+    File: DeadlineMonitor.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        processBlock timing against the buffer deadline (numSamples / rate).
+        The audio thread is the only writer: a fixed histogram of block load
+        (duration / deadline), worst case and an overrun counter, all plain
+        atomics. Any other thread can read percentiles or dump a report.
+*/
+
+#pragma once
+#include "JuceIncludes.h"
+#include <atomic>
+
+class DeadlineMonitor {
+public:
+    static constexpr int binsPerUnit = 256;          // load resolution: 1/256 of the deadline
+    static constexpr int numBins = 4 * binsPerUnit;  // 0..400 %, the last bin also takes anything above
+
+    struct Stats {
+        juce::uint64 blocks = 0, overruns = 0;
+        double meanLoad = 0.0, p99Load = 0.0, p999Load = 0.0, worstLoad = 0.0; // 1.0 = whole deadline
+        double worstMicros = 0.0;
+    };
+
+    // Times one processBlock from construction to destruction (audio thread)
+    struct Scope {
+        Scope (DeadlineMonitor& m, int n) : monitor (m), numSamples (n), start (juce::Time::getHighResolutionTicks()) {}
+        ~Scope() { monitor.record (start, juce::Time::getHighResolutionTicks(), numSamples); }
+        DeadlineMonitor& monitor; int numSamples; juce::int64 start;
+    };
+
+    void prepare (double sampleRate);                // audio stopped; clears everything
+    void record (juce::int64 startTicks, juce::int64 endTicks, int numSamples) noexcept; // audio thread
+
+    // Any thread. reset() takes effect at the next recorded block.
+    void reset() { resetRequested.store (true); }
+    Stats getStats() const;
+    float getLastLoad() const { return lastLoad.load (std::memory_order_relaxed); } // most recent block
+    juce::String getReport() const;                  // stats plus the non-empty histogram bins
+    bool writeReport (const juce::File& file) const;
+
+private:
+    void clear() noexcept;
+
+    double sampleRate = 44100.0;
+    const double ticksToSeconds = 1.0 / (double) juce::Time::getHighResolutionTicksPerSecond();
+
+    std::atomic<juce::uint32> bins[numBins] {};
+    std::atomic<juce::uint64> overruns { 0 }; // the block count is the histogram total
+    std::atomic<double> busySeconds { 0.0 }, budgetSeconds { 0.0 };
+    std::atomic<float> worstLoad { 0.0f }, worstMicros { 0.0f }, lastLoad { 0.0f };
+    std::atomic<bool> resetRequested { false };
+};
@@ -0,0 +1,182 @@
+/*
+    File: RealtimeCheck.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Allocation and lock hooks behind MS_RT_CHECK. The replacement
+        operators and the glibc malloc / pthread_mutex_lock interposers go
+        straight to the underlying allocator; while a violation is being
+        recorded (backtrace, bookkeeping) the thread's own allocations and
+        locks are not reported again.
+*/
+
+#include "RealtimeCheck.h"
+
+#if MS_RT_CHECK
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+#if defined (__GLIBC__)
+ #include <dlfcn.h>
+ #include <pthread.h>
+ extern "C" {
+     void* __libc_malloc (size_t);
+     void* __libc_calloc (size_t, size_t);
+     void* __libc_realloc (void*, size_t);
+     void  __libc_free (void*);
+     void* __libc_memalign (size_t, size_t);
+ }
+ #define MS_RT_HOOK_LIBC 1
+#else
+ #define MS_RT_HOOK_LIBC 0
+#endif
+
+using namespace juce;
+
+namespace {
+
+thread_local int audioDepth = 0;    // > 0 inside ScopedAudioThread
+thread_local bool reporting = false; // recording a violation: do not recurse
+
+struct Registry {
+    std::mutex lock;
+    std::vector<RealtimeCheck::Violation> sites;
+};
+
+Registry& registry() { static Registry r; return r; }
+
+void* rawMalloc (size_t n) {
+   #if MS_RT_HOOK_LIBC
+    return __libc_malloc (n);
+   #else
+    return std::malloc (n);
+   #endif
+}
+
+void rawFree (void* p) {
+   #if MS_RT_HOOK_LIBC
+    __libc_free (p);
+   #else
+    std::free (p);
+   #endif
+}
+
+void* rawAlignedMalloc (size_t n, size_t align) {
+   #if MS_RT_HOOK_LIBC
+    return __libc_memalign (align, n);
+   #else
+    return std::aligned_alloc (align, (n + align - 1) / align * align); // size must be a multiple
+   #endif
+}
+
+void* checkedNew (size_t n) {
+    RealtimeCheck::report ("operator new");
+    if (auto* p = rawMalloc (n == 0 ? 1 : n)) return p;
+    throw std::bad_alloc();
+}
+
+void* checkedNew (size_t n, std::align_val_t align) {
+    RealtimeCheck::report ("operator new (aligned)");
+    if (auto* p = rawAlignedMalloc (n == 0 ? 1 : n, (size_t) align)) return p;
+    throw std::bad_alloc();
+}
+
+void checkedDelete (void* p) {
+    if (p == nullptr) return;
+    RealtimeCheck::report ("operator delete");
+    rawFree (p);
+}
+
+} // namespace
+
+namespace RealtimeCheck {
+
+ScopedAudioThread::ScopedAudioThread()  { ++audioDepth; }
+ScopedAudioThread::~ScopedAudioThread() { --audioDepth; }
+
+void report (const char* kind) noexcept {
+    if (audioDepth == 0 || reporting) return;
+    reporting = true;
+
+    try {
+        const auto stack = SystemStats::getStackBacktrace();
+        auto& r = registry();
+        const std::lock_guard<std::mutex> sl (r.lock);
+
+        auto it = std::find_if (r.sites.begin(), r.sites.end(),
+                                [&] (const Violation& v) { return v.stack == stack && v.kind == kind; });
+        if (it != r.sites.end()) ++it->count;
+        else r.sites.push_back ({ kind, stack, 1 });
+    }
+    catch (...) {}
+
+    reporting = false;
+}
+
+std::vector<Violation> getViolations() {
+    auto& r = registry();
+    const std::lock_guard<std::mutex> sl (r.lock);
+    return r.sites;
+}
+
+void clearViolations() {
+    auto& r = registry();
+    const std::lock_guard<std::mutex> sl (r.lock);
+    r.sites.clear();
+}
+
+} // namespace RealtimeCheck
+
+// Replacement global allocation functions
+void* operator new   (size_t n)                         { return checkedNew (n); }
+void* operator new[] (size_t n)                         { return checkedNew (n); }
+void* operator new   (size_t n, const std::nothrow_t&) noexcept { try { return checkedNew (n); } catch (...) { return nullptr; } }
+void* operator new[] (size_t n, const std::nothrow_t&) noexcept { try { return checkedNew (n); } catch (...) { return nullptr; } }
+void operator delete   (void* p) noexcept                         { checkedDelete (p); }
+void operator delete[] (void* p) noexcept                         { checkedDelete (p); }
+void operator delete   (void* p, size_t) noexcept                 { checkedDelete (p); }
+void operator delete[] (void* p, size_t) noexcept                 { checkedDelete (p); }
+void operator delete   (void* p, const std::nothrow_t&) noexcept  { checkedDelete (p); }
+void operator delete[] (void* p, const std::nothrow_t&) noexcept  { checkedDelete (p); }
+
+// Aligned overloads: alignas (64) types such as the arena voices
+void* operator new   (size_t n, std::align_val_t a)                         { return checkedNew (n, a); }
+void* operator new[] (size_t n, std::align_val_t a)                         { return checkedNew (n, a); }
+void* operator new   (size_t n, std::align_val_t a, const std::nothrow_t&) noexcept { try { return checkedNew (n, a); } catch (...) { return nullptr; } }
+void* operator new[] (size_t n, std::align_val_t a, const std::nothrow_t&) noexcept { try { return checkedNew (n, a); } catch (...) { return nullptr; } }
+void operator delete   (void* p, std::align_val_t) noexcept                        { checkedDelete (p); }
+void operator delete[] (void* p, std::align_val_t) noexcept                        { checkedDelete (p); }
+void operator delete   (void* p, size_t, std::align_val_t) noexcept                { checkedDelete (p); }
+void operator delete[] (void* p, size_t, std::align_val_t) noexcept                { checkedDelete (p); }
+void operator delete   (void* p, std::align_val_t, const std::nothrow_t&) noexcept { checkedDelete (p); }
+void operator delete[] (void* p, std::align_val_t, const std::nothrow_t&) noexcept { checkedDelete (p); }
+
+#if MS_RT_HOOK_LIBC
+extern "C" {
+
+void* malloc (size_t n)             { RealtimeCheck::report ("malloc");  return __libc_malloc (n); }
+void* calloc (size_t n, size_t s)   { RealtimeCheck::report ("calloc");  return __libc_calloc (n, s); }
+void* realloc (void* p, size_t n)   { RealtimeCheck::report ("realloc"); return __libc_realloc (p, n); }
+void  free (void* p)                { if (p != nullptr) RealtimeCheck::report ("free"); __libc_free (p); }
+
+// Blocking mutex acquisition (CriticalSection, std::mutex); try-locks are allowed
+int pthread_mutex_lock (pthread_mutex_t* m) {
+    using Fn = int (*) (pthread_mutex_t*);
+    static std::atomic<Fn> next { nullptr }; // constant-initialised: no guard variable, no lock
+    auto fn = next.load (std::memory_order_acquire);
+    if (fn == nullptr) {
+        fn = reinterpret_cast<Fn> (dlsym (RTLD_NEXT, "pthread_mutex_lock"));
+        next.store (fn, std::memory_order_release);
+    }
+    RealtimeCheck::report ("pthread_mutex_lock");
+    return fn (m);
+}
+
+} // extern "C"
+#endif
+
+#endif // MS_RT_CHECK
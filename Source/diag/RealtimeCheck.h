@@ -0,0 +1,49 @@
+/*
+    File: RealtimeCheck.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Real-time safety checker for debug/CI builds (MS_RT_CHECK=1, CMake
+        option MINISYNTH_RT_CHECK). While a thread is inside a
+        ScopedAudioThread, global operator new/delete, and on glibc also
+        malloc/calloc/realloc/free and pthread_mutex_lock, are recorded as
+        violations together with the offending call stack. Without
+        MS_RT_CHECK the scope is empty and nothing is intercepted.
+*/
+
+#pragma once
+#include "JuceIncludes.h"
+#include <vector>
+
+#ifndef MS_RT_CHECK
+ #define MS_RT_CHECK 0
+#endif
+
+namespace RealtimeCheck {
+
+// One distinct offending call site
+struct Violation { juce::String kind, stack; int count = 0; };
+
+#if MS_RT_CHECK
+struct ScopedAudioThread {
+    ScopedAudioThread();
+    ~ScopedAudioThread();
+    JUCE_DECLARE_NON_COPYABLE (ScopedAudioThread)
+};
+
+// Called by the hooks; records a violation if the calling thread is flagged
+void report (const char* kind) noexcept;
+
+std::vector<Violation> getViolations();
+void clearViolations();
+#else
+struct ScopedAudioThread { ScopedAudioThread() {} };
+
+inline std::vector<Violation> getViolations() { return {}; }
+inline void clearViolations() {}
+#endif
+
+constexpr bool isEnabled() { return MS_RT_CHECK != 0; }
+
+} // namespace RealtimeCheck
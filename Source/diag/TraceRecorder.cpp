@@ -0,0 +1,165 @@
+/*
+    File: TraceRecorder.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Bounded multi-producer / single-consumer ring (per-cell sequence
+        numbers, one CAS per event) and the writer thread that turns it into
+        Chrome trace-event JSON every 50 ms.
+*/
+
+#include "TraceRecorder.h"
+
+using namespace juce;
+
+std::atomic<bool> TraceRecorder::active { false };
+
+namespace {
+std::atomic<int> nextThreadIndex { 1 };
+std::atomic<uint32> traceGeneration { 0 }; // bumped by start(): threads name themselves again
+}
+
+class TraceRecorder::Writer : public Thread {
+public:
+    explicit Writer (TraceRecorder& r) : Thread ("MiniSynth trace writer"), owner (r) {}
+    void run() override {
+        while (! threadShouldExit()) { owner.flush(); wait (50); }
+    }
+private:
+    TraceRecorder& owner;
+};
+
+TraceRecorder& TraceRecorder::get() {
+    static TraceRecorder instance;
+    return instance;
+}
+
+TraceRecorder::TraceRecorder() : writer (std::make_unique<Writer> (*this)), cells (new Cell[capacity]) {
+    for (int i = 0; i < capacity; ++i) cells[i].sequence.store ((uint64) i, std::memory_order_relaxed);
+}
+
+TraceRecorder::~TraceRecorder() { stop(); }
+
+int TraceRecorder::threadIndex() noexcept {
+    thread_local const int index = nextThreadIndex++;
+    return index;
+}
+
+bool TraceRecorder::start (const File& file) {
+    stop();
+
+    // Discard whatever late producers left behind from the previous session
+    { const ScopedLock sl (flushLock); Event e; while (pop (e)) {} }
+
+    file.deleteFile();
+    auto stream = std::make_unique<FileOutputStream> (file);
+    if (stream->failedToOpen()) return false;
+
+    {
+        const ScopedLock sl (flushLock);
+        out = std::move (stream);
+        *out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        firstEvent = true;
+        originTicks = Time::getHighResolutionTicks();
+    }
+    dropped.store (0);
+    ++traceGeneration;
+    active.store (true);
+    writer->startThread();
+    return true;
+}
+
+void TraceRecorder::stop() {
+    if (! active.exchange (false)) return;
+    writer->stopThread (1000);
+
+    flush();
+    const ScopedLock sl (flushLock);
+    *out << "\n]}\n";
+    out->flush();
+    out.reset();
+}
+
+bool TraceRecorder::push (const Event& e) noexcept {
+    auto pos = enqueuePos.load (std::memory_order_relaxed);
+    for (;;) {
+        auto& cell = cells[(int) (pos & (capacity - 1))];
+        const auto seq = cell.sequence.load (std::memory_order_acquire);
+        const auto diff = (int64) seq - (int64) pos;
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed)) {
+                cell.event = e;
+                cell.sequence.store (pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0) { dropped.fetch_add (1, std::memory_order_relaxed); return false; } // full
+        else pos = enqueuePos.load (std::memory_order_relaxed);
+    }
+}
+
+bool TraceRecorder::pop (Event& e) noexcept {
+    auto& cell = cells[(int) (dequeuePos & (capacity - 1))];
+    if (cell.sequence.load (std::memory_order_acquire) != dequeuePos + 1) return false;
+    e = cell.event;
+    cell.sequence.store (dequeuePos + capacity, std::memory_order_release);
+    ++dequeuePos;
+    return true;
+}
+
+void TraceRecorder::span (const char* name, const char* category, int64 startTicks, int64 endTicks, int arg) noexcept {
+    push ({ Event::Span, name, category, startTicks, endTicks - startTicks, threadIndex(), arg });
+}
+
+void TraceRecorder::instant (const char* name, const char* category, int arg) noexcept {
+    push ({ Event::Instant, name, category, Time::getHighResolutionTicks(), 0, threadIndex(), arg });
+}
+
+void TraceRecorder::counter (const char* name, int value) noexcept {
+    push ({ Event::Counter, name, "", Time::getHighResolutionTicks(), 0, threadIndex(), value });
+}
+
+void TraceRecorder::nameThread (const char* name) noexcept {
+    thread_local uint32 namedIn = 0;
+    const auto generation = traceGeneration.load (std::memory_order_relaxed);
+    if (namedIn == generation) return;
+    namedIn = generation;
+    push ({ Event::ThreadName, name, "", 0, 0, threadIndex(), 0 });
+}
+
+void TraceRecorder::flush() {
+    const ScopedLock sl (flushLock);
+    if (out == nullptr) return;
+
+    const double ticksToMicros = 1.0e6 / (double) Time::getHighResolutionTicksPerSecond();
+    auto micros = [&] (int64 ticks) { return String ((double) ticks * ticksToMicros, 3); };
+
+    String chunk;
+    Event e;
+    while (pop (e)) {
+        chunk << (firstEvent ? "" : ",\n");
+        firstEvent = false;
+
+        const String common ("\"pid\":1,\"tid\":" + String (e.thread));
+        switch (e.kind) {
+            case Event::Span:
+                chunk << "{\"ph\":\"X\",\"name\":\"" << e.name << "\",\"cat\":\"" << e.category << "\",\"ts\":" << micros (e.ticks - originTicks)
+                      << ",\"dur\":" << micros (e.durationTicks) << "," << common << ",\"args\":{\"v\":" << e.arg << "}}";
+                break;
+            case Event::Instant:
+                chunk << "{\"ph\":\"i\",\"s\":\"t\",\"name\":\"" << e.name << "\",\"cat\":\"" << e.category << "\",\"ts\":" << micros (e.ticks - originTicks)
+                      << "," << common << ",\"args\":{\"v\":" << e.arg << "}}";
+                break;
+            case Event::Counter:
+                chunk << "{\"ph\":\"C\",\"name\":\"" << e.name << "\",\"ts\":" << micros (e.ticks - originTicks)
+                      << "," << common << ",\"args\":{\"value\":" << e.arg << "}}";
+                break;
+            case Event::ThreadName:
+                chunk << "{\"ph\":\"M\",\"name\":\"thread_name\"," << common << ",\"args\":{\"name\":\"" << e.name << "\"}}";
+                break;
+        }
+    }
+
+    if (chunk.isNotEmpty()) { *out << chunk; out->flush(); }
+}
@@ -0,0 +1,78 @@
+/*
+    File: TraceRecorder.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Optional Chrome / Perfetto trace of audio-thread activity. Spans,
+        instants and counters go into a preallocated lock-free ring (any
+        thread may write; writers never block or allocate, a full ring
+        drops the event) and a background thread streams them to a
+        trace-event JSON file (load it in ui.perfetto.dev or chrome://tracing).
+        When no trace is running each probe costs one relaxed atomic load.
+*/
+
+#pragma once
+#include "JuceIncludes.h"
+#include <atomic>
+
+class TraceRecorder {
+public:
+    static TraceRecorder& get();
+    static bool isActive() noexcept { return active.load (std::memory_order_relaxed); }
+
+    // Message thread. start() truncates 'file'; stop() flushes and closes it.
+    bool start (const juce::File& file);
+    void stop();
+    juce::uint64 getNumDropped() const { return dropped.load(); }
+
+    // Any thread, real-time safe. 'name' and 'category' must be string literals.
+    void span (const char* name, const char* category, juce::int64 startTicks, juce::int64 endTicks, int arg) noexcept;
+    void instant (const char* name, const char* category, int arg) noexcept;
+    void counter (const char* name, int value) noexcept;
+    void nameThread (const char* name) noexcept; // label for the calling thread in the viewer
+
+    // Records [construction, destruction) as a span if a trace is running at both ends
+    struct Scope {
+        Scope (const char* n, const char* c, int a) noexcept : name (n), category (c), arg (a),
+                                                               start (isActive() ? juce::Time::getHighResolutionTicks() : 0) {}
+        ~Scope() { if (start != 0 && isActive()) get().span (name, category, start, juce::Time::getHighResolutionTicks(), arg); }
+        const char* name; const char* category; int arg; juce::int64 start;
+    };
+
+private:
+    TraceRecorder();
+    ~TraceRecorder();
+
+    struct Event {
+        enum Kind : juce::uint8 { Span, Instant, Counter, ThreadName } kind;
+        const char* name; const char* category;
+        juce::int64 ticks, durationTicks;
+        int thread, arg;
+    };
+    struct Cell { std::atomic<juce::uint64> sequence { 0 }; Event event; };
+
+    static constexpr int capacity = 1 << 16; // events, ~4 MB: several seconds of a busy patch between flushes
+    static std::atomic<bool> active;
+
+    bool push (const Event& e) noexcept;
+    bool pop (Event& e) noexcept;
+    void flush();
+    static int threadIndex() noexcept;
+
+    class Writer;
+    std::unique_ptr<Writer> writer;
+    std::unique_ptr<Cell[]> cells;
+    std::atomic<juce::uint64> enqueuePos { 0 };
+    juce::uint64 dequeuePos = 0;                  // writer thread only
+    std::atomic<juce::uint64> dropped { 0 };
+    juce::int64 originTicks = 0;
+    std::unique_ptr<juce::FileOutputStream> out;
+    bool firstEvent = true;
+    juce::CriticalSection flushLock;              // writer thread vs. stop(); never taken by producers
+};
+
+#define MS_TRACE_JOIN2(a, b) a##b
+#define MS_TRACE_JOIN(a, b) MS_TRACE_JOIN2 (a, b)
+#define MS_TRACE_SCOPE(name, category, arg) const TraceRecorder::Scope MS_TRACE_JOIN (msTraceScope, __LINE__) (name, category, arg)
+#define MS_TRACE_INSTANT(name, category, arg) do { if (TraceRecorder::isActive()) TraceRecorder::get().instant (name, category, arg); } while (false)
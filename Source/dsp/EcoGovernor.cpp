@@ -0,0 +1,68 @@
+/*
+    File: EcoGovernor.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Load smoothing, tier stepping with hysteresis, and the per-tier
+        voice quality settings.
+*/
+
+#include "EcoGovernor.h"
+
+using namespace juce;
+
+namespace {
+constexpr double smoothingSeconds = 0.1; // load EMA time constant
+constexpr double settleSeconds = 0.25;   // minimum time between two steps down in quality
+}
+
+void EcoGovernor::setThresholds (const Thresholds& t) {
+    up.store (jlimit (0.05f, 2.0f, t.up));
+    down.store (jlimit (0.0f, up.load(), t.down));
+    holdSeconds.store (jmax (0.0f, t.holdSeconds));
+}
+
+EcoGovernor::Thresholds EcoGovernor::getThresholds() const {
+    return { up.load(), down.load(), holdSeconds.load() };
+}
+
+void EcoGovernor::prepare (double sr) {
+    sampleRate = sr;
+    smoothed = 0.0f;
+    belowFor = sinceStep = 0.0;
+    tier.store (Full);
+}
+
+int EcoGovernor::update (float load, int numSamples, bool enabled, int maxTier) noexcept {
+    int t = tier.load (std::memory_order_relaxed);
+    if (! enabled) {
+        smoothed = 0.0f; belowFor = 0.0;
+        if (t != Full) tier.store (Full, std::memory_order_relaxed);
+        return Full;
+    }
+
+    const double seconds = numSamples / sampleRate;
+    smoothed += (float) (1.0 - std::exp (-seconds / smoothingSeconds)) * (load - smoothed);
+    sinceStep += seconds;
+    belowFor = smoothed < down.load (std::memory_order_relaxed) ? belowFor + seconds : 0.0;
+
+    if ((smoothed > up.load (std::memory_order_relaxed) || load > 1.0f) && t < maxTier && sinceStep >= settleSeconds) {
+        ++t; sinceStep = 0.0;
+    }
+    else if (t > 0 && belowFor >= holdSeconds.load (std::memory_order_relaxed)) {
+        --t; sinceStep = 0.0; belowFor = 0.0; // one tier per hold period
+    }
+    t = jmin (t, jlimit (0, numTiers - 1, maxTier)); // the cap may have been lowered
+
+    tier.store (t, std::memory_order_relaxed);
+    return t;
+}
+
+SynthVoice::Quality EcoGovernor::qualityFor (int t) {
+    SynthVoice::Quality q;
+    q.unison      = t < NoUnison;
+    q.cheapShapes = t >= CheapShapes;
+    q.modInterval = t >= SlowModulation ? 16 : 1;
+    return q;
+}
@@ -0,0 +1,50 @@
+/*
+    File: EcoGovernor.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Adaptive CPU governor ("eco mode"). Fed the load of each processBlock
+        (duration / deadline), it steps down one quality tier at a time when
+        the smoothed load crosses the upper threshold or a block overruns,
+        and steps back up only after the load has stayed under the lower
+        threshold for a hold time. Tiers are cumulative:
+          0 Full
+          1 No Unison      second unison copy skipped
+          2 Cheap Shapes   naive Tri, rational tanh Fold
+          3 Slow Mod       pitch / cutoff modulation every 16 samples
+          4 4 Voices       oldest held notes released beyond 4
+*/
+
+#pragma once
+#include "SynthVoice.h"
+#include <atomic>
+
+class EcoGovernor {
+public:
+    enum Tier { Full, NoUnison, CheapShapes, SlowModulation, ReducedPolyphony, numTiers };
+    static constexpr int reducedPolyphony = 4;
+
+    // Loads are fractions of the block deadline
+    struct Thresholds { float up = 0.70f, down = 0.40f, holdSeconds = 2.0f; };
+
+    void setThresholds (const Thresholds& t);   // any thread
+    Thresholds getThresholds() const;
+
+    void prepare (double sampleRate);
+
+    // Audio thread, once per block: 'load' of the previous block, the block about to be
+    // rendered, and the user's eco settings. Returns the tier to render this block at.
+    int update (float load, int numSamples, bool enabled, int maxTier) noexcept;
+
+    int getTier() const { return tier.load (std::memory_order_relaxed); } // any thread
+    static SynthVoice::Quality qualityFor (int tier);
+
+private:
+    double sampleRate = 44100.0;
+    std::atomic<float> up { 0.70f }, down { 0.40f }, holdSeconds { 2.0f };
+
+    float smoothed = 0.0f;
+    double belowFor = 0.0, sinceStep = 0.0; // seconds
+    std::atomic<int> tier { Full };
+};
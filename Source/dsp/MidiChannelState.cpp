@@ -0,0 +1,106 @@
+/*
+    File: MidiChannelState.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Controller bookkeeping, MPE Configuration Message handling and zone
+        queries.
+*/
+
+#include "MidiChannelState.h"
+
+using namespace juce;
+
+MidiChannelState::MidiChannelState (const params::Block& paramBlock) : p (paramBlock) {
+    std::fill (std::begin (wheel), std::end (wheel), 8192);
+    std::fill (std::begin (timbreValue), std::end (timbreValue), 64);
+    std::fill (std::begin (rpnMsb), std::end (rpnMsb), 127);
+    std::fill (std::begin (rpnLsb), std::end (rpnLsb), 127);
+
+    setMpeZones (15, 0); // MPE default: one lower zone over all channels
+}
+
+void MidiChannelState::update (const MidiMessage& m) {
+    const int ch = m.getChannel();
+    if (ch < 1 || ch > 16) return;
+
+    if (m.isPitchWheel())           wheel[ch] = m.getPitchWheelValue();
+    else if (m.isChannelPressure()) pressureValue[ch] = m.getChannelPressureValue();
+    else if (m.isController()) {
+        const int value = m.getControllerValue();
+        switch (m.getControllerNumber()) {
+            case 64:  sustain[ch] = value >= 64; break;
+            case 74:  timbreValue[ch] = value; break; // MPE timbre (slide)
+            case 101: rpnMsb[ch] = value; break;
+            case 100: rpnLsb[ch] = value; break;
+
+            case 6: { // data entry for the selected RPN
+                const int rpn = rpnMsb[ch] * 128 + rpnLsb[ch];
+                if (rpn == 6 && (ch == 1 || ch == 16)) {
+                    const int zone = ch == 1 ? 0 : 1;
+                    configureZone (zone, value);
+                    zones[zone].masterBendRange = 2.0f; // MPE default once a controller declares its zone
+                } else if (rpn == 0)
+                    for (auto& z : zones)
+                        if (z.enabled() && z.master == ch) z.masterBendRange = (float) value;
+                break;
+            }
+            default: break;
+        }
+    }
+}
+
+void MidiChannelState::clearSustain (int channel) {
+    if (channel == 0) std::fill (std::begin (sustain), std::end (sustain), false);
+    else sustain[channel] = false;
+}
+
+void MidiChannelState::setMpeZones (int lowerMemberChannels, int upperMemberChannels) {
+    configureZone (0, lowerMemberChannels);
+    configureZone (1, upperMemberChannels);
+}
+
+void MidiChannelState::configureZone (int zone, int memberChannels) {
+    memberChannels = jlimit (0, 15, memberChannels);
+    auto& z = zones[zone];
+    z.masterBendRange = -1.0f;
+    if (zone == 0) { z.master = 1;  z.firstMember = 2;                   z.lastMember = 1 + memberChannels; }
+    else           { z.master = 16; z.firstMember = 16 - memberChannels; z.lastMember = 15; }
+
+    // The most recently configured zone wins any overlap
+    if (! z.enabled()) return;
+    auto& other = zones[1 - zone];
+    if (zone == 0) other.firstMember = jmax (other.firstMember, z.lastMember + 1);
+    else           other.lastMember  = jmin (other.lastMember,  z.firstMember - 1);
+}
+
+int MidiChannelState::zoneOf (int channel) const {
+    if (! mpeActive()) return -1;
+    for (int z = 0; z < 2; ++z)
+        if (zones[z].enabled() && (channel == zones[z].master
+                                   || (channel >= zones[z].firstMember && channel <= zones[z].lastMember)))
+            return z;
+    return -1;
+}
+
+bool MidiChannelState::controls (int msgChannel, int voiceChannel) const {
+    return msgChannel == voiceChannel || (isMaster (msgChannel) && zoneOf (voiceChannel) == zoneOf (msgChannel));
+}
+
+bool MidiChannelState::sustainHeld (int channel) const {
+    const int z = zoneOf (channel);
+    return sustain[channel] || (z >= 0 && sustain[zones[z].master]);
+}
+
+float MidiChannelState::noteBendSemitones (int channel) const {
+    if (isMaster (channel)) return 0.0f; // notes on a master channel follow the zone bend only
+    return (wheel[channel] - 8192) / 8192.0f * p[params::idx::bendRange];
+}
+
+float MidiChannelState::masterBendSemitones (int channel) const {
+    const int z = zoneOf (channel);
+    if (z < 0) return 0.0f;
+    const float range = zones[z].masterBendRange < 0.0f ? p[params::idx::bendRange] : zones[z].masterBendRange;
+    return (wheel[zones[z].master] - 8192) / 8192.0f * range;
+}
@@ -0,0 +1,61 @@
+/*
+    File: MidiChannelState.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Per-channel MIDI controller state and MPE zone layout, shared by the
+        real-time VoiceManager and the offline note pre-scan so both route
+        bend, pressure, timbre and sustain by the same rules.
+*/
+
+#pragma once
+#include "JuceIncludes.h"
+#include "ParameterSpecs.h"
+
+class MidiChannelState {
+public:
+    explicit MidiChannelState (const params::Block& paramBlock);
+
+    // Records wheel, pressure, CC64/CC74 and RPN data (MPE configuration, master
+    // bend range). Call before routing the message to voices. Until a controller sends
+    // an MPE Configuration Message or RPN 0, master bend follows the bendRange parameter,
+    // so a plain keyboard on channel 1 bends as it would with MPE off.
+    void update (const juce::MidiMessage& m);
+    void clearSustain (int channel); // 0 = all channels
+
+    // MPE zone layout (member channel counts, 0 disables a zone). Controllers can also
+    // change it with an MPE Configuration Message (RPN 6 on channel 1 or 16).
+    void setMpeZones (int lowerMemberChannels, int upperMemberChannels);
+
+    bool mpeActive() const { return p[params::idx::mpeEnabled] > 0.5f; }
+    int zoneOf (int channel) const; // -1 outside the zones or with MPE off
+    bool isMaster (int channel) const { const int z = zoneOf (channel); return z >= 0 && zones[z].master == channel; }
+    bool controls (int msgChannel, int voiceChannel) const; // same channel, or master of its zone
+    bool sustainHeld (int channel) const;
+
+    // Current expression of a note starting on 'channel', in voice event units
+    float noteBendSemitones (int channel) const;
+    float masterBendSemitones (int channel) const;
+    // Master-channel pressure is ignored: MPE pressure is per note, on member channels
+    float pressure (int channel) const { return isMaster (channel) ? 0.0f : pressureValue[channel] / 127.0f; }
+    float timbre (int channel) const   { return mpeActive() ? (timbreValue[channel] - 64) / 64.0f : 0.0f; }
+
+private:
+    // Lower zone: master 1, members 2..; upper zone: master 16, members ..15
+    struct Zone {
+        int master = 1, firstMember = 2, lastMember = 1; // empty when lastMember < firstMember
+        float masterBendRange = -1.0f;                   // semitones, RPN 0 on the master channel; < 0 = bendRange
+        bool enabled() const { return lastMember >= firstMember; }
+    };
+
+    void configureZone (int zone, int memberChannels);
+
+    const params::Block& p;
+    Zone zones[2];
+
+    // Last value per MIDI channel (1-16)
+    int wheel[17], pressureValue[17] {}, timbreValue[17];
+    bool sustain[17] {}; // CC64
+    int rpnMsb[17], rpnLsb[17];
+};
@@ -0,0 +1,104 @@
+/*
+    File: MidiThinner.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        MIDI thinning implementation: one pass marks superseded and repeated
+        events, a second pass copies the survivors back into the host buffer.
+*/
+
+#include "MidiThinner.h"
+
+using namespace juce;
+
+MidiThinner::MidiThinner() : keys ((size_t) numKeys), keep ((size_t) maxEvents) {
+    scratch.ensureSize (maxBytes);
+}
+
+void MidiThinner::prepare (double sr) {
+    sampleRate = sr;
+    reset();
+}
+
+void MidiThinner::reset() {
+    std::fill (keys.begin(), keys.end(), KeyState {});
+    for (auto& e : channelEpoch) ++e;
+}
+
+int MidiThinner::keyFor (const uint8* d, int numBytes, int& value) {
+    if (numBytes < 2) return -1;
+    const int ch = d[0] & 0x0f;
+
+    switch (d[0] & 0xf0) {
+        case 0xe0: if (numBytes < 3) return -1; value = d[1] | (d[2] << 7); return ch;
+        case 0xd0: value = d[1]; return 16 + ch;
+        case 0xa0: if (numBytes < 3) return -1; value = d[2]; return 32 + ch * 128 + (d[1] & 0x7f);
+        case 0xb0: {
+            if (numBytes < 3) return -1;
+            const int cc = d[1] & 0x7f;
+            // Bank select, data entry, switches, (N)RPN selection and channel mode stay exact
+            if (cc == 0 || cc == 32 || cc == 6 || cc == 38 || (cc >= 64 && cc <= 69)
+                || (cc >= 96 && cc <= 101) || cc >= 120) return -1;
+            value = d[2]; return 32 + 16 * 128 + ch * 128 + cc;
+        }
+        default: return -1;
+    }
+}
+
+void MidiThinner::track (const uint8* d, int numBytes) {
+    // The voices see this value, so a later change back to the old one is not a repeat
+    int value = 0;
+    const int key = keyFor (d, numBytes, value);
+    if (key >= 0) { keys[(size_t) key].value = value; keys[(size_t) key].pending = -1; }
+}
+
+void MidiThinner::process (MidiBuffer& midi) {
+    const int window = (int) (windowMs.load() * 0.001 * sampleRate);
+    if (midi.isEmpty()) return;
+    if (window <= 0 || midi.data.size() > maxBytes) { // off, or scratch would have to grow
+        for (const auto meta : midi) track (meta.data, meta.numBytes);
+        return;
+    }
+
+    for (auto& e : channelEpoch) ++e; // pending indices never outlive the block
+
+    uint64 numMerged = 0, numDropped = 0;
+    int index = 0;
+    for (const auto meta : midi) {
+        if (index >= maxEvents) { track (meta.data, meta.numBytes); continue; }
+        keep[(size_t) index] = 1;
+
+        int value = 0;
+        const int key = keyFor (meta.data, meta.numBytes, value);
+        const int ch = meta.data[0] & 0x0f;
+
+        if (key < 0) {
+            if (meta.data[0] < 0xf0) ++channelEpoch[ch]; // notes etc. close this channel's windows
+        } else {
+            auto& s = keys[(size_t) key];
+            const bool open = s.pending >= 0 && s.epoch == channelEpoch[ch]
+                              && meta.samplePosition - s.groupStart < window;
+
+            if (value == s.value) { keep[(size_t) index] = 0; ++numDropped; }
+            else if (open)        { keep[(size_t) s.pending] = 0; ++numMerged; s.pending = index; s.value = value; }
+            else                  { s = { value, index, meta.samplePosition, channelEpoch[ch] }; }
+        }
+        ++index;
+    }
+
+    if (numMerged + numDropped == 0) return;
+
+    // Survivors are never more bytes than the input, so neither buffer reallocates
+    scratch.clear();
+    index = 0;
+    for (const auto meta : midi) {
+        if (index >= maxEvents || keep[(size_t) index]) scratch.addEvent (meta.data, meta.numBytes, meta.samplePosition);
+        ++index;
+    }
+    midi.clear();
+    midi.addEvents (scratch, 0, -1, 0);
+
+    merged += numMerged;
+    dropped += numDropped;
+}
@@ -0,0 +1,65 @@
+/*
+    File: MidiThinner.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Pre-dispatch MIDI thinning. Runs of continuous messages (pitch wheel,
+        channel/poly pressure, continuous CCs) on the same channel and
+        controller are coalesced to the last value in each time window, and
+        repeats of the value already in effect are dropped. Note, switch,
+        RPN/NRPN and system messages pass through untouched and act as
+        barriers, so expression sent ahead of a note-on stays ahead of it.
+*/
+
+#pragma once
+#include "JuceIncludes.h"
+#include <atomic>
+#include <vector>
+
+class MidiThinner {
+public:
+    MidiThinner();
+
+    // Message thread. 0 disables thinning.
+    void setWindowMs (float ms) { windowMs.store (juce::jmax (0.0f, ms)); }
+    float getWindowMs() const { return windowMs.load(); }
+
+    void prepare (double sampleRate);
+    void reset();
+
+    // Audio thread. Rewrites 'midi' without allocating; events beyond the
+    // preallocated capacity are passed through unthinned, but still update the
+    // value in effect.
+    void process (juce::MidiBuffer& midi);
+
+    // Events removed because a later one in the same window superseded them
+    juce::uint64 getNumMerged() const { return merged.load(); }
+    // Events removed because they repeated the value already in effect
+    juce::uint64 getNumDropped() const { return dropped.load(); }
+
+private:
+    // pitch wheel (16) + channel pressure (16) + poly pressure (16 x 128) + CC (16 x 128)
+    static constexpr int numKeys = 16 + 16 + 16 * 128 + 16 * 128;
+    static constexpr int maxEvents = 4096;
+    static constexpr int maxBytes = 64 * 1024;
+
+    struct KeyState {
+        int value = -1;                // last value passed on, -1 = unknown
+        int pending = -1;              // event index that currently carries it
+        int groupStart = 0;            // sample position that opened the window
+        juce::uint32 epoch = 0;        // pending is only valid while this matches the channel's
+    };
+
+    static int keyFor (const juce::uint8* data, int numBytes, int& value);
+    void track (const juce::uint8* data, int numBytes); // event passed on unthinned
+
+    std::vector<KeyState> keys;
+    std::vector<juce::uint8> keep;     // per event of the current block
+    juce::MidiBuffer scratch;
+    juce::uint32 channelEpoch[16] {};
+    double sampleRate = 44100.0;
+
+    std::atomic<float> windowMs { 1.0f };
+    std::atomic<juce::uint64> merged { 0 }, dropped { 0 };
+};
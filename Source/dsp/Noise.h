@@ -19,6 +19,9 @@ struct NoiseBus {
 
     void prepare (const juce::dsp::ProcessSpec&) {}
 
+    // Reproducible sequence (offline renders); the default seed is time-based
+    void seed (juce::int64 s) { rng.setSeed (s); pinkState = brownState = hpX = hpY = 0.0f; }
+
     inline float white() { return rng.nextFloat() * 2.0f - 1.0f; }
     inline float pink()  { pinkState  = 0.98f * pinkState  + 0.02f * white(); return pinkState; }
     inline float brown() { brownState = juce::jlimit (-1.0f, 1.0f, brownState + 0.02f * white()); return brownState; }
@@ -0,0 +1,204 @@
+/*
+    File: NoteCache.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Freeze checks, the render thread, LRU eviction within the memory
+        budget, and deferred freeing of samples voices may still read.
+*/
+
+#include "NoteCache.h"
+
+using namespace juce;
+
+// Renders queued notes; polls like the trace writer, so the audio thread never signals it
+class NoteCache::Renderer : public Thread {
+public:
+    explicit Renderer (NoteCache& c) : Thread ("MiniSynth note cache"), owner (c) {}
+
+    void run() override {
+        while (! threadShouldExit()) {
+            owner.collect();
+            for (;;) {
+                Request r;
+                {
+                    const auto scope = owner.fifo.read (1);
+                    if (scope.blockSize1 == 0) break;
+                    r = owner.queue[scope.startIndex1];
+                }
+                owner.render (r);
+                if (threadShouldExit()) return;
+            }
+            wait (10);
+        }
+    }
+
+private:
+    NoteCache& owner;
+};
+
+NoteCache::NoteCache (size_t budgetBytes) : budget (budgetBytes) {}
+
+NoteCache::~NoteCache() {
+    stopRenderer();
+    for (auto& s : slots) delete s.exchange (nullptr); // voices are gone or no longer render
+}
+
+void NoteCache::prepare (double sr, int chunk, std::shared_ptr<const DspTables> t) {
+    stopRenderer();
+    for (int n = 0; n < 128; ++n) { retire (n); requested[n].store (0); }
+    fifo.reset();
+    collect();
+
+    sampleRate = sr; maxChunk = jmax (1, chunk); tables = std::move (t);
+    renderer = std::make_unique<Renderer> (*this);
+    renderer->startThread();
+}
+
+void NoteCache::stopRenderer() {
+    if (renderer != nullptr) renderer->stopThread (5000);
+    renderer.reset();
+}
+
+bool NoteCache::isFreezable (const params::Block& v) noexcept {
+    namespace idx = params::idx;
+    if (v[idx::freezeOn] < 0.5f || v[idx::sustain] > 0.0f) return false;
+    if (v[idx::attack] + v[idx::decay] + v[idx::release] > maxNoteSeconds) return false;
+
+    if (v[idx::lfoDepth]  != 0.0f && (int) v[idx::lfoTarget]  != 0) return false;
+    if (v[idx::lfo2Depth] != 0.0f && (int) v[idx::lfo2Target] != 0) return false;
+
+    // The render holds the filter envelope through note-off, where a live voice releases it
+    // from wherever it is: only the same when the envelope moves nothing
+    if (v[idx::fAmt] != 0.0f) return false;
+
+    const int waves[] = { idx::osc1Wave, idx::osc2Wave, idx::osc3Wave };
+    const int tables[] = { idx::tableOn1, idx::tableOn2, idx::tableOn3 };
+    const int pwmDepths[] = { idx::pwmDepth1, idx::pwmDepth2, idx::pwmDepth3 };
+    for (int i = 0; i < 3; ++i) {
+        const int wave = (int) v[waves[i]];
+        if (v[tables[i]] > 0.5f) return false;                      // user table: can be swapped under the cache
+        if (wave == 2 && v[pwmDepths[i]] != 0.0f) return false;     // free-running PWM LFO
+    }
+    return true;
+}
+
+uint64 NoteCache::patchKey (const params::Block& v) noexcept {
+    uint64 h = 14695981039346656037ull; // FNV-1a over the value bits
+    for (int i = 0; i < params::count; ++i) {
+        if (params::specs[i].output) continue; // reported state, not sound
+        uint32 bits; std::memcpy (&bits, &v.values[i], sizeof (bits));
+        for (int b = 0; b < 4; ++b) { h ^= (bits >> (8 * b)) & 0xff; h *= 1099511628211ull; }
+    }
+    return h != 0 ? h : 1; // 0 = nothing requested
+}
+
+void NoteCache::beginBlock() noexcept { inBlock.store (true); }
+
+void NoteCache::endBlock() noexcept {
+    inBlock.store (false);
+    blocksDone.fetch_add (1);
+}
+
+const FrozenNote* NoteCache::acquire (uint64 key, int note, const TuningTable& tuning, const params::Block& values) noexcept {
+    if (! isPositiveAndBelow (note, 128)) return nullptr;
+
+    // A retuned note is a different render
+    uint32 bits; std::memcpy (&bits, &tuning.hz[note], sizeof (bits));
+    const uint64 patch = (key ^ bits) * 1099511628211ull | 1;
+
+    // Freed only after this block ends, and never while users > 0
+    if (auto* s = slots[note].load(); s != nullptr && s->patch == patch) {
+        s->users.fetch_add (1);
+        s->lastUsed.store (++clock);
+        return s;
+    }
+
+    if (requested[note].load() != patch) {
+        const auto scope = fifo.write (1);
+        if (scope.blockSize1 > 0) {                    // full: asked again on the next miss
+            queue[scope.startIndex1] = { patch, note, tuning.hz[note], tuning.log2Hz[note], values };
+            requested[note].store (patch);
+        }
+    }
+    return nullptr;
+}
+
+void NoteCache::render (const Request& r) {
+    if (auto* s = slots[r.note].load(); s != nullptr && s->patch == r.patch) return;
+
+    // Amp envelope held at 1: the playing voice applies the real one
+    auto values = r.values;
+    values.values[params::idx::attack] = values.values[params::idx::decay] = values.values[params::idx::release] = 0.0f;
+    values.values[params::idx::sustain] = 1.0f;
+
+    auto pitch = std::make_shared<TuningTable> (TuningTable::equal());
+    pitch->hz[r.note] = r.hz; pitch->log2Hz[r.note] = r.log2Hz;
+    renderTuning.set (std::move (pitch));
+    renderTuning.beginBlock();
+
+    auto voice = std::make_unique<SynthVoice> (values);
+    voice->setTuning (&renderTuning);
+    voice->prepare (sampleRate, maxChunk, 2, *tables);
+    voice->setNoiseSeed (r.note);
+    voice->queueEvent ({ 0, SynthVoice::Event::NoteOn, r.note, 1.0f });
+
+    auto s = std::make_unique<FrozenNote>();
+    s->patch = r.patch; s->note = r.note;
+    s->length = (int) std::ceil ((r.values[params::idx::attack] + r.values[params::idx::decay] + r.values[params::idx::release]) * sampleRate) + 1;
+    s->data.reset (new float[2 * (size_t) s->length]);
+
+    AudioBuffer<float> chunk (2, maxChunk);
+    for (int pos = 0; pos < s->length; pos += maxChunk) {
+        const int n = jmin (maxChunk, s->length - pos);
+        chunk.clear();
+        voice->renderNextBlock (chunk, 0, n);
+        for (int ch = 0; ch < 2; ++ch)
+            FloatVectorOperations::copy (s->data.get() + (size_t) ch * (size_t) s->length + (size_t) pos, chunk.getReadPointer (ch), n);
+    }
+    renderTuning.endBlock();
+    store (std::move (s));
+}
+
+void NoteCache::store (std::unique_ptr<FrozenNote> s) {
+    const auto bytes = [] (const FrozenNote& x) { return 2 * (size_t) x.length * sizeof (float); };
+    if (bytes (*s) > budget) return;
+
+    // Least recently played first, other patches before this one
+    retire (s->note);
+    while (bytesUsed.load() + bytes (*s) > budget) {
+        int victim = -1; bool victimSame = true; uint32 victimUsed = 0;
+        for (int n = 0; n < 128; ++n) {
+            const auto* x = slots[n].load();
+            if (x == nullptr) continue;
+            const bool same = x->patch == s->patch;
+            const auto used = x->lastUsed.load();
+            if (victim < 0 || (! same && victimSame) || (same == victimSame && used < victimUsed)) { victim = n; victimSame = same; victimUsed = used; }
+        }
+        if (victim < 0) break;
+        retire (victim);
+    }
+
+    s->lastUsed.store (clock.load());
+    bytesUsed.fetch_add (bytes (*s));
+    slots[s->note].store (s.release());
+}
+
+void NoteCache::retire (int note) {
+    auto* old = slots[note].exchange (nullptr);
+    if (old == nullptr) return;
+
+    bytesUsed.fetch_sub (2 * (size_t) old->length * sizeof (float));
+    auto patch = old->patch;
+    requested[note].compare_exchange_strong (patch, 0); // evicted: the next miss asks again
+    retired.push_back ({ std::unique_ptr<FrozenNote> (old), blocksDone.load() });
+}
+
+void NoteCache::collect() {
+    const bool idle = ! inBlock.load();
+    const auto done = blocksDone.load();
+    retired.erase (std::remove_if (retired.begin(), retired.end(),
+                                   [=] (const Retired& r) { return r.sample->users.load() == 0 && (idle || done > r.blocksAtSwap); }),
+                   retired.end());
+}
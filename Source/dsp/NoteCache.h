@@ -0,0 +1,101 @@
+/*
+    File: NoteCache.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Freeze mode. When the patch is deterministic and short (amp envelope
+        decays to silence, no free-running LFO or PWM modulation, no user
+        table), each played note is rendered once on a background thread and
+        later note-ons play the stored sample instead of running the voice
+        DSP. Samples are stored before the amp envelope, which the voice
+        still runs, so releases and kills behave as they do live. A miss
+        plays live and queues the render. Memory is capped; the least
+        recently played samples go first.
+*/
+
+#pragma once
+#include "SynthVoice.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// One rendered note, stereo, without the amp envelope. Held by a voice from
+// NoteCache::acquire() to release(); never freed while held.
+struct FrozenNote {
+    juce::uint64 patch = 0;
+    int note = 0, length = 0;
+    std::unique_ptr<float[]> data; // left then right, 'length' each
+    mutable std::atomic<int> users { 0 };
+    std::atomic<juce::uint32> lastUsed { 0 };
+
+    const float* channel (int ch) const noexcept { return data.get() + (size_t) ch * (size_t) length; }
+    void release() const noexcept { users.fetch_sub (1); }
+};
+
+class NoteCache {
+public:
+    static constexpr double maxNoteSeconds = 3.0;              // attack + decay + release
+    static constexpr size_t defaultBudgetBytes = 32u << 20;
+
+    explicit NoteCache (size_t budgetBytes = defaultBudgetBytes);
+    ~NoteCache();
+
+    // Message thread, processing stopped. Drops every sample not held by a voice.
+    void prepare (double sampleRate, int maxChunk, std::shared_ptr<const DspTables> tables);
+
+    // Freeze on, amp envelope silent after attack + decay, total length within
+    // maxNoteSeconds, no filter envelope amount, and nothing that moves
+    // between notes (LFOs, PWM LFOs, user tables)
+    static bool isFreezable (const params::Block& values) noexcept;
+    // Identifies the patch a sample was rendered from (acquire() adds the note's tuning)
+    static juce::uint64 patchKey (const params::Block& values) noexcept;
+
+    // Audio thread, around each block (see WavetableSlots)
+    void beginBlock() noexcept;
+    void endBlock() noexcept;
+
+    // Audio thread. The stored render of 'note' for this patch, already counted as held
+    // (call FrozenNote::release when done); nullptr on a miss, in which case a render is queued.
+    const FrozenNote* acquire (juce::uint64 patch, int note, const TuningTable& tuning, const params::Block& values) noexcept;
+
+    size_t getBytesUsed() const { return bytesUsed.load(); }
+
+private:
+    class Renderer;
+    struct Request { juce::uint64 patch; int note; float hz, log2Hz; params::Block values; };
+
+    void render (const Request& r);   // render thread
+    void store (std::unique_ptr<FrozenNote> s);
+    void retire (int note);
+    void collect();
+    void stopRenderer();
+
+    const size_t budget;
+    double sampleRate = 0.0;
+    int maxChunk = 64;
+    std::shared_ptr<const DspTables> tables;
+    TuningSlot renderTuning; // render thread: the requested note's pitch
+
+    // One slot per MIDI note: the patch key is checked on lookup
+    std::atomic<FrozenNote*> slots[128] {};
+    std::atomic<juce::uint64> requested[128] {};
+    std::atomic<juce::uint32> clock { 0 };
+    std::atomic<size_t> bytesUsed { 0 };
+
+    // Audio thread -> render thread
+    static constexpr int queueSize = 32;
+    juce::AbstractFifo fifo { queueSize };
+    Request queue[queueSize];
+
+    // Replaced or evicted samples, freed once no voice holds them and no block that
+    // could have picked them up is still running
+    struct Retired { std::unique_ptr<FrozenNote> sample; juce::uint64 blocksAtSwap; };
+    std::vector<Retired> retired;
+    std::atomic<bool> inBlock { false };
+    std::atomic<juce::uint64> blocksDone { 0 };
+
+    std::unique_ptr<Renderer> renderer;
+
+    JUCE_DECLARE_NON_COPYABLE (NoteCache)
+};
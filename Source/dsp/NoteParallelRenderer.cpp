@@ -0,0 +1,222 @@
+/*
+    File: NoteParallelRenderer.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Pre-scan (same routing rules as VoiceManager, one voice per note, no
+        stealing), per-note rendering on worker threads, and the in-order
+        mixdown.
+*/
+
+#include "NoteParallelRenderer.h"
+#include "MidiChannelState.h"
+#include "SharedTables.h"
+#include <thread>
+
+using namespace juce;
+
+NoteParallelRenderer::NoteParallelRenderer (double sr, int chunkSize)
+: sampleRate (sr), chunk (jmax (1, chunkSize)), tables (SharedTables::acquire (sr)) {}
+
+void NoteParallelRenderer::prepare (const MidiMessageSequence& midi, const params::Block& initial,
+                                    std::vector<AutomationPoint> automation, double tailSeconds) {
+    buildTimeline (initial, std::move (automation));
+
+    // The longest release anywhere on the timeline bounds how long a released note sounds
+    float maxRelease = 0.0f;
+    for (const auto& k : timeline) maxRelease = jmax (maxRelease, k.values[params::idx::release]);
+    tailSamples = (int64) std::ceil (maxRelease * sampleRate) + chunk;
+
+    length = (int64) std::ceil ((midi.getEndTime() + jmax (0.0, tailSeconds)) * sampleRate);
+    scan (midi);
+}
+
+void NoteParallelRenderer::buildTimeline (const params::Block& initial, std::vector<AutomationPoint> automation) {
+    std::stable_sort (automation.begin(), automation.end(),
+                      [] (const AutomationPoint& a, const AutomationPoint& b) { return a.seconds < b.seconds; });
+
+    timeline.clear();
+    timeline.push_back ({ 0, initial });
+    for (const auto& a : automation) {
+        if (! isPositiveAndBelow (a.index, params::count)) continue;
+
+        const auto c = jmax ((int64) 0, (int64) std::floor (a.seconds * sampleRate / chunk));
+        if (timeline.back().chunk != c) timeline.push_back ({ c, timeline.back().values });
+
+        const auto& s = params::specs[a.index];
+        timeline.back().values.values[a.index] = jlimit (s.start, s.end, a.value);
+    }
+}
+
+const params::Block& NoteParallelRenderer::valuesAt (int64 c, size_t& cursor) const {
+    while (cursor + 1 < timeline.size() && timeline[cursor + 1].chunk <= c) ++cursor;
+    return timeline[cursor].values;
+}
+
+void NoteParallelRenderer::scan (const MidiMessageSequence& midi) {
+    params::Block scanValues = timeline.front().values;
+    MidiChannelState channels (scanValues);
+    size_t cursor = 0;
+
+    struct Active { int index; bool keyDown = true, sustained = false; int64 releasedAt = -1; };
+    std::vector<Active> active;
+    notes.clear();
+
+    auto add = [this] (const Active& a, int64 t, SynthVoice::Event::Type type, float value) {
+        auto& n = notes[(size_t) a.index];
+        n.events.push_back ({ t, { 0, type, n.note, value } });
+    };
+    auto release = [&] (Active& a, int64 t, bool allowTailOff) {
+        add (a, t, allowTailOff ? SynthVoice::Event::NoteOff : SynthVoice::Event::Kill, 0.0f);
+        a.keyDown = a.sustained = false;
+        a.releasedAt = t;
+        notes[(size_t) a.index].end = jmin (length, t + tailSamples);
+    };
+    auto channelOf = [this] (const Active& a) { return notes[(size_t) a.index].channel; };
+
+    for (int i = 0; i < midi.getNumEvents(); ++i) {
+        const auto& m = midi.getEventPointer (i)->message;
+        const int ch = m.getChannel();
+        if (m.isMetaEvent() || ch < 1 || ch > 16) continue;
+
+        const auto t = jlimit ((int64) 0, length, (int64) std::llround (m.getTimeStamp() * sampleRate));
+        scanValues = valuesAt (t / chunk, cursor);
+
+        // Notes past their longest possible release take no more events
+        active.erase (std::remove_if (active.begin(), active.end(),
+                                      [&] (const Active& a) { return a.releasedAt >= 0 && t >= a.releasedAt + tailSamples; }),
+                      active.end());
+
+        channels.update (m);
+
+        if (m.isNoteOn()) {
+            for (auto& a : active)
+                if (notes[(size_t) a.index].note == m.getNoteNumber() && channelOf (a) == ch && (a.keyDown || a.sustained))
+                    release (a, t, true);
+
+            Note n; n.channel = ch; n.note = m.getNoteNumber(); n.start = t; n.end = length;
+            notes.push_back (std::move (n));
+            const Active a { (int) notes.size() - 1 };
+            add (a, t, SynthVoice::Event::NoteBend,   channels.noteBendSemitones (ch));
+            add (a, t, SynthVoice::Event::MasterBend, channels.masterBendSemitones (ch));
+            add (a, t, SynthVoice::Event::Pressure,   channels.pressure (ch));
+            add (a, t, SynthVoice::Event::Timbre,     channels.timbre (ch));
+            add (a, t, SynthVoice::Event::NoteOn,     m.getFloatVelocity());
+            active.push_back (a);
+        }
+        else if (m.isNoteOff()) {
+            for (auto& a : active) {
+                if (notes[(size_t) a.index].note != m.getNoteNumber() || channelOf (a) != ch || ! a.keyDown) continue;
+                if (channels.sustainHeld (ch)) { a.keyDown = false; a.sustained = true; }
+                else release (a, t, true);
+            }
+        }
+        else if (m.isAllNotesOff() || m.isAllSoundOff()) {
+            for (auto& a : active)
+                if (channels.controls (ch, channelOf (a))) release (a, t, ! m.isAllSoundOff());
+        }
+        else if (m.isPitchWheel()) {
+            const bool master = channels.isMaster (ch);
+            for (auto& a : active) {
+                if (master && channels.zoneOf (channelOf (a)) == channels.zoneOf (ch))
+                    add (a, t, SynthVoice::Event::MasterBend, channels.masterBendSemitones (channelOf (a)));
+                else if (! master && channelOf (a) == ch)
+                    add (a, t, SynthVoice::Event::NoteBend, channels.noteBendSemitones (ch));
+            }
+        }
+        else if (m.isChannelPressure()) {
+            for (auto& a : active)
+                if (channelOf (a) == ch) add (a, t, SynthVoice::Event::Pressure, channels.pressure (ch));
+        }
+        else if (m.isAftertouch()) {
+            for (auto& a : active)
+                if (channelOf (a) == ch && notes[(size_t) a.index].note == m.getNoteNumber())
+                    add (a, t, SynthVoice::Event::Pressure, m.getAfterTouchValue() / 127.0f);
+        }
+        else if (m.isSustainPedalOff()) {
+            for (auto& a : active)
+                if (a.sustained && channels.controls (ch, channelOf (a)) && ! channels.sustainHeld (channelOf (a)))
+                    release (a, t, true);
+        }
+        else if (m.isControllerOfType (74) && channels.mpeActive()) {
+            for (auto& a : active)
+                if (channelOf (a) == ch) add (a, t, SynthVoice::Event::Timbre, channels.timbre (ch));
+        }
+    }
+}
+
+void NoteParallelRenderer::renderNote (int index, AudioBuffer<float>& dest, int64& destStart) const {
+    ScopedNoDenormals noDenormals; // identical FTZ state on every worker and on the calling thread
+
+    const auto& n = notes[(size_t) index];
+    const int64 first = (n.start / chunk) * chunk; // stay on the global chunk grid
+    const int64 last = jmax (first, n.end);
+    destStart = first;
+    dest.setSize (2, (int) (last - first), false, false, false);
+    dest.clear();
+
+    size_t cursor = 0, ev = 0;
+    params::Block values = valuesAt (first / chunk, cursor);
+    SynthVoice voice (values);
+    voice.prepare (sampleRate, chunk, 2, *tables);
+    voice.setNoiseSeed (0x9e3779b9LL * (index + 1)); // per note, independent of scheduling
+
+    for (int64 pos = first; pos < last; pos += chunk) {
+        const int len = (int) jmin ((int64) chunk, last - pos);
+        values = valuesAt (pos / chunk, cursor);
+
+        for (; ev < n.events.size() && n.events[ev].time < pos + len; ++ev) {
+            auto e = n.events[ev].event;
+            e.offset = (int) (jmax (pos, n.events[ev].time) - pos);
+            voice.queueEvent (e);
+        }
+        voice.renderNextBlock (dest, (int) (pos - first), len);
+
+        if (ev == n.events.size() && ! voice.isSounding()) { // silent from here on
+            dest.setSize (2, (int) (pos + len - first), true, false, true);
+            break;
+        }
+    }
+}
+
+void NoteParallelRenderer::render (AudioBuffer<float>& output, int numThreads) {
+    jassert (output.getNumChannels() == 2 && output.getNumSamples() >= length);
+    output.clear();
+
+    const int count = getNumNotes();
+    std::atomic<int> nextNote { 0 };
+
+    // Finished notes wait here until every earlier note is mixed: the summing order
+    // is always note order, so the float result does not depend on scheduling.
+    CriticalSection mixLock;
+    std::vector<std::unique_ptr<AudioBuffer<float>>> finished ((size_t) count);
+    std::vector<int64> starts ((size_t) count);
+    int mixed = 0;
+
+    auto work = [&] {
+        for (int i; (i = nextNote++) < count;) { // idle workers take the next note
+            auto audio = std::make_unique<AudioBuffer<float>>();
+            int64 start = 0;
+            renderNote (i, *audio, start);
+
+            const ScopedLock sl (mixLock);
+            finished[(size_t) i] = std::move (audio);
+            starts[(size_t) i] = start;
+
+            for (; mixed < count && finished[(size_t) mixed] != nullptr; ++mixed) {
+                const auto& a = *finished[(size_t) mixed];
+                const int len = (int) jmin ((int64) a.getNumSamples(), length - starts[(size_t) mixed]);
+                for (int ch = 0; ch < 2 && len > 0; ++ch)
+                    output.addFrom (ch, (int) starts[(size_t) mixed], a, ch, 0, len);
+                finished[(size_t) mixed].reset();
+            }
+        }
+    };
+
+    if (numThreads <= 1) { work(); return; }
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < jmin (numThreads, count); ++t) workers.emplace_back (work);
+    for (auto& w : workers) w.join();
+}
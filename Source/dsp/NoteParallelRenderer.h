@@ -0,0 +1,58 @@
+/*
+    File: NoteParallelRenderer.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Offline note-parallel engine. A pre-scan of the whole MIDI sequence
+        gives every note its own virtual SynthVoice with a fixed event list,
+        parameter automation comes from a pre-recorded timeline, and notes
+        are rendered concurrently and summed in note order. The result is
+        bit-identical for any thread count.
+*/
+
+#pragma once
+#include "SynthVoice.h"
+#include <vector>
+
+class NoteParallelRenderer {
+public:
+    // Plain parameter value (spec units) taking effect at the chunk containing 'seconds'
+    struct AutomationPoint { double seconds; int index; float value; };
+
+    NoteParallelRenderer (double sampleRate, int chunkSize);
+
+    // 'midi' timestamps in seconds; 'initial' is the parameter state at time 0.
+    // Output length is the last MIDI event plus tailSeconds.
+    void prepare (const juce::MidiMessageSequence& midi, const params::Block& initial,
+                  std::vector<AutomationPoint> automation, double tailSeconds);
+
+    juce::int64 getLengthInSamples() const { return length; }
+    int getNumNotes() const { return (int) notes.size(); }
+
+    // Sums every note into 'output' (2 channels, getLengthInSamples() long, cleared here).
+    // numThreads <= 1 renders on the calling thread.
+    void render (juce::AudioBuffer<float>& output, int numThreads);
+
+private:
+    struct TimedEvent { juce::int64 time; SynthVoice::Event event; }; // event.offset unused here
+    struct Note {
+        int channel = 0, note = 0;
+        juce::int64 start = 0, end = 0;      // end: no sound is possible after this sample
+        std::vector<TimedEvent> events;
+    };
+    struct Keyframe { juce::int64 chunk; params::Block values; };
+
+    void buildTimeline (const params::Block& initial, std::vector<AutomationPoint> automation);
+    void scan (const juce::MidiMessageSequence& midi);
+    const params::Block& valuesAt (juce::int64 chunk, size_t& cursor) const;
+    void renderNote (int index, juce::AudioBuffer<float>& dest, juce::int64& destStart) const;
+
+    double sampleRate;
+    int chunk;
+    std::shared_ptr<const DspTables> tables;
+
+    std::vector<Keyframe> timeline;      // sorted by chunk, first at chunk 0
+    std::vector<Note> notes;             // in note-on order: also the summing order
+    juce::int64 length = 0, tailSamples = 0;
+};
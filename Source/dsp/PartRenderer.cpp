@@ -0,0 +1,206 @@
+/*
+    File: PartRenderer.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Part pool, worker threads, the per-span task hand-out and the
+        in-order bus sum. Chunks are claimed per part under a spin flag that
+        is dropped after every chunk, which is what lets the audio thread steal
+        the rest of a part from a preempted worker.
+*/
+
+#include "PartRenderer.h"
+#include "diag/RealtimeCheck.h"
+#include "diag/TraceRecorder.h"
+#include <thread>
+
+#if JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#elif JUCE_WINDOWS
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #include <windows.h>
+#else
+ #include <semaphore.h>
+ #include <cerrno>
+#endif
+
+using namespace juce;
+
+// Posting must not take a lock (juce::WaitableEvent does): it runs on the audio thread
+struct PartRenderer::Wake {
+#if JUCE_MAC || JUCE_IOS
+    dispatch_semaphore_t s = dispatch_semaphore_create (0);
+    ~Wake() { dispatch_release (s); }
+    void post() noexcept { dispatch_semaphore_signal (s); }
+    void wait() noexcept { dispatch_semaphore_wait (s, DISPATCH_TIME_FOREVER); }
+#elif JUCE_WINDOWS
+    HANDLE s = CreateSemaphore (nullptr, 0, 0x7fffffff, nullptr);
+    ~Wake() { CloseHandle (s); }
+    void post() noexcept { ReleaseSemaphore (s, 1, nullptr); }
+    void wait() noexcept { WaitForSingleObject (s, INFINITE); }
+#else
+    sem_t s;
+    Wake() { sem_init (&s, 0, 0); }
+    ~Wake() { sem_destroy (&s); }
+    void post() noexcept { sem_post (&s); }
+    void wait() noexcept { while (sem_wait (&s) != 0 && errno == EINTR) {} }
+#endif
+};
+
+// Parked until the audio thread posts a span, then claims chunks like the audio thread does,
+// starting from its own part so the threads do not all queue on part 1
+class PartRenderer::Worker : public Thread {
+public:
+    Worker (PartRenderer& o, int i) : Thread ("MiniSynth parts " + String (i)), owner (o), index (i) {}
+
+    void run() override {
+        while (! threadShouldExit()) {
+            owner.wake->wait();
+            if (threadShouldExit()) break;
+            if (TraceRecorder::isActive()) TraceRecorder::get().nameThread ("parts");
+            const RealtimeCheck::ScopedAudioThread audioThread; // no-op unless MS_RT_CHECK
+            owner.runTasks (index);
+        }
+    }
+
+private:
+    PartRenderer& owner;
+    const int index;
+};
+
+PartRenderer::PartRenderer (const UserTables& t, const TuningSlot& tun) : userTables (t), tuning (tun), wake (std::make_unique<Wake>()) {}
+
+PartRenderer::~PartRenderer() { stopWorkers(); }
+
+void PartRenderer::prepare (double sr, int chunk, int span, int channels, const DspTables& t) {
+    sampleRate = sr; maxChunk = chunk; maxSpan = jmax (1, span); numChannels = channels; tables = &t;
+    for (auto& p : parts) {
+        p->voices.prepare (sampleRate, maxChunk, numChannels, t);
+        p->bus.setSize (numChannels, maxSpan);
+    }
+}
+
+void PartRenderer::setNumParts (int n, const params::Block& initial, int numThreads) {
+    n = jlimit (1, maxParts, n);
+    stopWorkers();
+
+    while ((int) parts.size() > n - 1) parts.pop_back();
+    while ((int) parts.size() < n - 1) {
+        auto p = std::make_unique<Part> (initial);
+        p->voices.setUserTables (&userTables);
+        p->voices.setTuning (&tuning);
+        p->voices.setChannel ((int) parts.size() + 2);
+        if (tables != nullptr) {
+            p->voices.prepare (sampleRate, maxChunk, numChannels, *tables);
+            p->bus.setSize (numChannels, maxSpan);
+        }
+        parts.push_back (std::move (p));
+    }
+    numParts.store (n);
+
+    // Real-time like the audio thread that waits on them; plain highest priority if refused
+    for (int i = 0; i < jmin (jmax (0, numThreads), n - 1); ++i) {
+        workers.push_back (std::make_unique<Worker> (*this, i + 1));
+        if (! workers.back()->startRealtimeThread (Thread::RealtimeOptions().withPriority (10)))
+            workers.back()->startThread (Thread::Priority::highest);
+    }
+}
+
+void PartRenderer::stopWorkers() {
+    for (auto& w : workers) w->signalThreadShouldExit();
+    for (size_t i = 0; i < workers.size(); ++i) wake->post();
+    for (auto& w : workers) w->stopThread (2000);
+    workers.clear();
+}
+
+void PartRenderer::setPartValues (int part, const params::Block& values) {
+    if (! isPositiveAndBelow (part - 1, (int) parts.size())) return;
+    auto& p = *parts[(size_t) (part - 1)];
+    const SpinLock::ScopedLockType sl (p.lock);
+    p.pending = values;
+    p.hasPending = true;
+}
+
+void PartRenderer::setNoiseSeed (int64 seed) {
+    for (size_t i = 0; i < parts.size(); ++i) parts[i]->voices.setNoiseSeed (seed + 1000 * (int64) (i + 1));
+}
+
+uint64 PartRenderer::getEventsDropped() const {
+    uint64 n = 0;
+    for (const auto& p : parts) n += p->voices.getEventsDropped();
+    return n;
+}
+
+void PartRenderer::beginBlock() noexcept {
+    for (auto& p : parts) {
+        const SpinLock::ScopedTryLockType sl (p->lock); // busy: keep last block's patch
+        if (sl.isLocked() && p->hasPending) { p->block = p->pending; p->hasPending = false; }
+    }
+}
+
+void PartRenderer::render (VoiceManager& main, AudioBuffer<float>& out, const MidiBuffer& midi, int start, int num, int chunk) noexcept {
+    job.main = &main; job.out = &out; job.midi = &midi; job.chunk = jmax (1, chunk);
+    for (int s = start; s < start + num; s += maxSpan)
+        dispatch (s, jmin (maxSpan, start + num - s));
+}
+
+void PartRenderer::dispatch (int start, int num) noexcept {
+    const int n = numParts.load (std::memory_order_relaxed);
+    job.start = start; job.num = num;
+    const auto chunks = (uint32) ((num + job.chunk - 1) / job.chunk);
+    jassert (chunks <= 0xffff);
+    done.store (0, std::memory_order_relaxed);
+    for (int i = 0; i < n; ++i)
+        lanes[i].cursor.store (chunks << 16, std::memory_order_release); // publishes the job to that part's claims
+    for (size_t i = 0; i < workers.size(); ++i) wake->post();
+
+    // Anything a worker claimed and left between chunks is taken over here; the wait is
+    // only ever for a chunk being rendered right now
+    runTasks (0);
+    for (int spins = 0; done.load (std::memory_order_acquire) < n; ++spins) {
+        runTasks (0);
+        if (spins > 64) std::this_thread::yield();
+    }
+
+    for (int p = 1; p < n; ++p) {
+        const auto& bus = parts[(size_t) (p - 1)]->bus;
+        for (int ch = 0; ch < out.getNumChannels(); ++ch)
+            out.addFrom (ch, start, bus, jmin (ch, bus.getNumChannels() - 1), 0, num);
+    }
+}
+
+void PartRenderer::runTasks (int firstPart) noexcept {
+    const ScopedNoDenormals noDenormals;
+    const int n = numParts.load (std::memory_order_relaxed);
+    for (int k = 0; k < n; ++k) {
+        const int i = (firstPart + k) % n;
+        auto& lane = lanes[i];
+        // Chunks of one part must run in order: take the part, claim and render one chunk, let go
+        while (! lane.busy.exchange (true, std::memory_order_acquire)) {
+            const auto claim = lane.cursor.load (std::memory_order_acquire);
+            const int chunk = (int) (claim & 0xffff), count = (int) (claim >> 16);
+            if (chunk >= count) { lane.busy.store (false, std::memory_order_release); break; }
+
+            lane.cursor.store (claim + 1, std::memory_order_relaxed); // only the holder moves it
+            {
+                MS_TRACE_SCOPE ("part", "audio", i + 1);
+                renderChunk (i, chunk);
+            }
+            lane.busy.store (false, std::memory_order_release);
+            if (chunk == count - 1) done.fetch_add (1, std::memory_order_release);
+        }
+    }
+}
+
+void PartRenderer::renderChunk (int part, int chunk) noexcept {
+    const int at = job.start + chunk * job.chunk;
+    const int num = jmin (job.chunk, job.start + job.num - at);
+    if (part == 0) { job.main->renderNextBlock (*job.out, *job.midi, at, num); return; }
+
+    auto& p = *parts[(size_t) (part - 1)];
+    if (chunk == 0) p.bus.clear (0, job.num);
+    p.voices.renderNextBlock (p.bus, at - job.start, *job.midi, at, num);
+}
@@ -0,0 +1,105 @@
+/*
+    File: PartRenderer.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Multi-timbral mode. Part 1 is the processor's own VoiceManager and
+        patch; parts 2..16 each own a parameter snapshot, a voice pool and a
+        stereo bus, and listen to MIDI channel 2..16. Each span is rendered
+        chunk by chunk per part, claimed by the audio thread and a few parked
+        real-time worker threads alike. A part is released between chunks,
+        so when a worker is preempted the audio thread takes over the rest
+        of its part and waits on one chunk at most. The parts' buses are then
+        added to the output in part order, so the mix does not depend on which
+        thread rendered what. Waking the workers takes no lock on the audio
+        thread.
+*/
+
+#pragma once
+#include "VoiceManager.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class PartRenderer {
+public:
+    static constexpr int maxParts = 16;
+    static constexpr int voicesPerPart = 8;
+
+    PartRenderer (const UserTables& userTables, const TuningSlot& tuning);
+    ~PartRenderer();
+
+    // Message thread, processing stopped. maxSpan: largest render() span in one go (longer
+    // ones are split).
+    void prepare (double sampleRate, int maxChunk, int maxSpan, int numChannels, const DspTables& tables);
+
+    // Message thread, processing stopped. 1 = off; new parts start from 'initial'.
+    // numThreads: workers besides the audio thread (capped at numParts - 1).
+    void setNumParts (int numParts, const params::Block& initial, int numThreads);
+    int getNumParts() const { return numParts.load(); }
+
+    // Message thread: the patch that parts[part - 1] (part 1..15, i.e. MIDI channel part + 1)
+    // plays from the next block
+    void setPartValues (int part, const params::Block& values);
+
+    // Audio thread, once per block: picks up new part patches
+    void beginBlock() noexcept;
+    // Audio thread. Renders 'main' (part 1) into 'out' and the other parts into their
+    // buses over [start, start + num), chunk samples at a time, then adds the buses to 'out'.
+    void render (VoiceManager& main, juce::AudioBuffer<float>& out, const juce::MidiBuffer& midi, int start, int num, int chunk) noexcept;
+
+    // Eco governor and offline hosts, forwarded to parts 2..16
+    void setQuality (const SynthVoice::Quality& q) { for (auto& p : parts) p->voices.setQuality (q); }
+    void limitPolyphony (int maxNotes) { for (auto& p : parts) p->voices.limitPolyphony (maxNotes); }
+    void setNoiseSeed (juce::int64 seed);
+    juce::uint64 getEventsDropped() const; // parts 2..16, see VoiceManager
+
+private:
+    struct Part {
+        explicit Part (const params::Block& initial) : block (initial), voices (voicesPerPart, block) {}
+        params::Block block;            // what the voices read (audio thread)
+        VoiceManager voices;
+        juce::AudioBuffer<float> bus;
+        juce::SpinLock lock;            // guards pending
+        params::Block pending;
+        bool hasPending = false;
+    };
+
+    class Worker;
+    struct Wake;                        // counting semaphore, lock-free to post
+
+    void dispatch (int start, int num) noexcept;
+    void runTasks (int firstPart) noexcept;
+    void renderChunk (int part, int chunk) noexcept;
+    void stopWorkers();
+
+    const UserTables& userTables;
+    const TuningSlot& tuning;
+    std::vector<std::unique_ptr<Part>> parts; // parts 2..16
+    std::atomic<int> numParts { 1 };
+
+    // Prepared settings, for parts added later
+    double sampleRate = 0.0;
+    int maxChunk = 64, maxSpan = 0, numChannels = 2;
+    const DspTables* tables = nullptr;
+
+    // Current span, written by the audio thread before the lanes are reset
+    struct Job { VoiceManager* main; juce::AudioBuffer<float>* out; const juce::MidiBuffer* midi; int start, num, chunk; };
+    Job job {};
+
+    // One per part (0 = main). 'cursor' packs the next chunk (low 16 bits) with the span's chunk
+    // count (high bits), so a claim never reads 'job' to know whether it got work.
+    // Only the thread holding 'busy' advances it.
+    struct alignas (64) Lane {
+        std::atomic<bool> busy { false };       // held while claiming and rendering one chunk
+        std::atomic<juce::uint32> cursor { 0 }; // 0 chunks: nothing to claim
+    };
+    Lane lanes[maxParts];
+    std::atomic<int> done { 0 };               // parts whose last chunk is rendered
+
+    std::unique_ptr<Wake> wake;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    JUCE_DECLARE_NON_COPYABLE (PartRenderer)
+};
@@ -20,10 +20,7 @@ public:
     void forceReset() { phase = 0.0; }
     double getPhase() const { return phase; }
 
-    void setFrequency (double f) {
-        freq = juce::jlimit (0.0, sampleRate * 0.45, f);
-        incr = freq / sampleRate;
-    }
+    void setFrequency (double f) { incr = juce::jlimit (0.0, sampleRate * 0.45, f) / sampleRate; }
     void setMode (Mode m) { mode = m; }
 
     float processSample() {
@@ -41,7 +38,6 @@ private:
         return 0.0f;
     }
 
-    double sampleRate = 44100.0;
-    double freq = 0.0, incr = 0.0, phase = 0.0;
+    double sampleRate = 44100.0, incr = 0.0, phase = 0.0;
     Mode mode = SawUp;
 };
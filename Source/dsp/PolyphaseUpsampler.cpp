@@ -0,0 +1,121 @@
+/*
+    File: PolyphaseUpsampler.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Prototype filter design and the streaming polyphase loop.
+*/
+
+#include "PolyphaseUpsampler.h"
+#include <numeric>
+
+using namespace juce;
+
+namespace {
+// Zeroth-order modified Bessel function (power series), for the Kaiser window
+double besselI0 (double x) {
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 50 && term > 1.0e-12 * sum; ++k) { term *= (x / (2.0 * k)) * (x / (2.0 * k)); sum += term; }
+    return sum;
+}
+
+constexpr double kaiserBeta = 8.0; // ~80 dB stopband
+}
+
+bool PolyphaseUpsampler::prepare (double inRate, double outRate, int maxOutBlock, int numChannels) {
+    active = false;
+    const int in = roundToInt (inRate), out = roundToInt (outRate);
+    if (in <= 0 || out <= in) return false;
+
+    const int g = std::gcd (in, out);
+    L = out / g; M = in / g;
+    if (L > maxPhases) return false;
+
+    // Prototype at L x the input rate, cutoff at the input Nyquist, DC gain L
+    const int n = tapsPerPhase * L;
+    const double fc = 0.5 / L, centre = 0.5 * (n - 1);
+    std::vector<double> h ((size_t) n);
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+        const double t = i - centre;
+        const double sinc = t == 0.0 ? 2.0 * fc : std::sin (MathConstants<double>::twoPi * fc * t) / (MathConstants<double>::pi * t);
+        const double r = t / centre;
+        h[(size_t) i] = sinc * besselI0 (kaiserBeta * std::sqrt (jmax (0.0, 1.0 - r * r))) / besselI0 (kaiserBeta);
+        sum += h[(size_t) i];
+    }
+
+    coeffs.assign ((size_t) n, 0.0f);
+    for (int p = 0; p < L; ++p)
+        for (int k = 0; k < tapsPerPhase; ++k)
+            coeffs[(size_t) (p * tapsPerPhase + k)] = (float) (h[(size_t) (p + (tapsPerPhase - 1 - k) * L)] * L / sum);
+
+    maxOut = jmax (1, maxOutBlock);
+    maxIn = 1 + (L - 1 + (maxOut - 1) * M) / L;
+    latency = roundToInt (centre / M);
+    history.setSize (jmax (1, numChannels), tapsPerPhase + maxIn);
+    reset();
+    active = true;
+    return true;
+}
+
+void PolyphaseUpsampler::reset() {
+    history.clear();
+    historyStart = -(tapsPerPhase - 1); // zeros before the first input
+    newest = -1;
+    next = 0;
+    phase = 0;
+}
+
+int PolyphaseUpsampler::getInputNeeded (int numOut) const {
+    if (numOut <= 0) return 0;
+    const int64 last = next + (phase + (int64) (numOut - 1) * M) / L;
+    return (int) jmax ((int64) 0, last - newest);
+}
+
+int PolyphaseUpsampler::getInputIndexFor (int outOffset) const {
+    return (int) (next + (phase + (int64) outOffset * M) / L - (newest + 1));
+}
+
+void PolyphaseUpsampler::process (const AudioBuffer<float>& in, int numIn, AudioBuffer<float>& out, int outStart, int numOut) noexcept {
+    jassert (active && numOut <= maxOut && numIn == getInputNeeded (numOut));
+    const int channels = jmin (history.getNumChannels(), out.getNumChannels());
+    const int appendAt = (int) (newest + 1 - historyStart);
+
+    const int64 startNext = next;
+    const int startPhase = phase;
+    for (int ch = 0; ch < channels; ++ch) {
+        float* hist = history.getWritePointer (ch);
+        if (numIn > 0) FloatVectorOperations::copy (hist + appendAt, in.getReadPointer (jmin (ch, in.getNumChannels() - 1)), numIn);
+
+        float* dst = out.getWritePointer (ch, outStart);
+        int64 j = startNext; int ph = startPhase;
+        for (int i = 0; i < numOut; ++i) {
+            // Oldest of the 32 inputs feeding this output, dotted with this phase's taps
+            const float* x = hist + (j - (tapsPerPhase - 1) - historyStart);
+            const float* c = coeffs.data() + ph * tapsPerPhase;
+            float a0 = 0.0f, a1 = 0.0f, a2 = 0.0f, a3 = 0.0f;
+            for (int k = 0; k < tapsPerPhase; k += 4) {
+                a0 += c[k] * x[k]; a1 += c[k + 1] * x[k + 1];
+                a2 += c[k + 2] * x[k + 2]; a3 += c[k + 3] * x[k + 3];
+            }
+            dst[i] = (a0 + a1) + (a2 + a3);
+
+            ph += M;
+            while (ph >= L) { ph -= L; ++j; }
+        }
+        if (ch == channels - 1) { next = j; phase = ph; }
+    }
+    newest += numIn;
+
+    // Keep only what the next output still needs: inputs from next - 31 on
+    const int64 keepFrom = next - (tapsPerPhase - 1);
+    const int drop = (int) (keepFrom - historyStart), keep = (int) (newest - keepFrom + 1);
+    if (drop > 0) {
+        for (int ch = 0; ch < history.getNumChannels(); ++ch) {
+            float* hist = history.getWritePointer (ch);
+            std::memmove (hist, hist + drop, sizeof (float) * (size_t) keep);
+        }
+        historyStart = keepFrom;
+    }
+}
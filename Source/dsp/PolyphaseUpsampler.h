@@ -0,0 +1,53 @@
+/*
+    File: PolyphaseUpsampler.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Streaming rational upsampler (L / M, from integer rates) taking the
+        voice engine's output to the host rate. Kaiser-windowed sinc prototype,
+        32 taps per phase, cutoff at half the engine rate: flat to about
+        20 kHz at a 48 kHz engine rate, images attenuated by about 80 dB.
+        All buffers are sized in prepare(); process() never allocates.
+*/
+
+#pragma once
+#include "JuceIncludes.h"
+#include <vector>
+
+class PolyphaseUpsampler {
+public:
+    static constexpr int tapsPerPhase = 32;
+    static constexpr int maxPhases = 512; // L above this (odd host rates): stay inactive
+
+    // Message thread. Active only when outRate > inRate and the reduced ratio is small
+    // enough; returns isActive().
+    bool prepare (double inRate, double outRate, int maxOutBlock, int numChannels);
+    void reset();
+
+    bool isActive() const { return active; }
+    int getMaxOutput() const { return maxOut; }
+    int getMaxInput() const { return maxIn; }          // largest getInputNeeded() for <= getMaxOutput()
+    int getLatencySamples() const { return latency; }  // group delay, at the output rate
+
+    // Engine samples to feed process() so it can emit the next numOut samples
+    int getInputNeeded (int numOut) const;
+    // Index, in that input span, of the engine sample lined up with output sample 'outOffset'
+    // (negative when it was already consumed by the previous call)
+    int getInputIndexFor (int outOffset) const;
+
+    // Audio thread. 'in' holds exactly getInputNeeded (numOut) samples; writes (replaces)
+    // numOut samples at outStart. numOut <= getMaxOutput().
+    void process (const juce::AudioBuffer<float>& in, int numIn, juce::AudioBuffer<float>& out, int outStart, int numOut) noexcept;
+
+private:
+    bool active = false;
+    int L = 1, M = 1;                 // output / input rate ratio, reduced
+    int maxOut = 0, maxIn = 0, latency = 0;
+    std::vector<float> coeffs;        // per phase, taps reversed (oldest input first)
+
+    juce::AudioBuffer<float> history; // input samples [historyStart, newest]
+    juce::int64 historyStart = 0, newest = -1;
+    juce::int64 next = 0;             // input index of the next output sample ...
+    int phase = 0;                    // ... and its sub-sample position, in 1/L
+};
@@ -17,10 +17,7 @@ public:
     void reset() { phase = 0.0; incr = 0.0; }
     void forceReset() { phase = 0.0; }
 
-    void setFrequency (double f) {
-        freq = juce::jlimit (0.0, sampleRate * 0.45, f);
-        incr = freq / sampleRate;
-    }
+    void setFrequency (double f) { incr = juce::jlimit (0.0, sampleRate * 0.45, f) / sampleRate; }
     void setPulseWidth (float pw01) { pw = juce::jlimit (0.01f, 0.99f, pw01); }
     void setRoundedEdges (bool b) { roundedEdges = b; }
 
@@ -42,6 +39,6 @@ private:
         return 0.0f;
     }
 
-    double sampleRate = 44100.0, freq = 0.0, incr = 0.0, phase = 0.0;
+    double sampleRate = 44100.0, incr = 0.0, phase = 0.0;
     float pw = 0.5f; bool roundedEdges = true;
 };
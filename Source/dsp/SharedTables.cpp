@@ -0,0 +1,45 @@
+/*
+    File: SharedTables.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Table construction and the process-wide, per-sample-rate registry.
+*/
+
+#include "SharedTables.h"
+#include <map>
+
+using namespace juce;
+
+DspTables::DspTables (double sr) : sampleRate (sr) {
+    for (int i = 0; i <= sineSize; ++i)
+        sineTable[i] = (float) std::sin (MathConstants<double>::twoPi * i / sineSize);
+
+    for (int n = 0; n < 128; ++n)
+        noteHz[n] = (float) MidiMessage::getMidiNoteInHertz (n);
+
+    log2MinCutoff = std::log2 (minCutoff);
+    log2MaxCutoff = std::log2 (maxCutoff);
+    const double nyquistGuard = 0.49 * sampleRate;
+    for (int i = 0; i <= prewarpSize; ++i) {
+        const double log2Hz = log2MinCutoff + (log2MaxCutoff - log2MinCutoff) * i / prewarpSize;
+        const double fc = jmin (std::exp2 (log2Hz), nyquistGuard);
+        prewarpTable[i] = (float) std::tan (MathConstants<double>::pi * fc / sampleRate);
+    }
+}
+
+std::shared_ptr<const DspTables> SharedTables::acquire (double sampleRate) {
+    static CriticalSection lock;
+    static std::map<int64, std::weak_ptr<const DspTables>> registry; // keyed by rate in mHz
+
+    const auto key = (int64) std::llround (sampleRate * 1000.0);
+    const ScopedLock sl (lock);
+
+    auto& slot = registry[key];
+    if (auto existing = slot.lock()) return existing;
+
+    std::shared_ptr<const DspTables> tables = std::make_shared<DspTables> (sampleRate);
+    slot = tables;
+    return tables;
+}
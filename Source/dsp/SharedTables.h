@@ -0,0 +1,50 @@
+/*
+    File: SharedTables.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Read-only DSP tables (sine, note pitch, SVF prewarp) shared by every
+        voice of every plugin instance in the process. Built lazily once per
+        sample rate and reference counted: the last instance to let go of a
+        rate frees its tables.
+*/
+
+#pragma once
+#include "JuceIncludes.h"
+#include <memory>
+
+struct DspTables {
+    static constexpr int sineSize    = 2048;
+    static constexpr int prewarpSize = 1024;
+    static constexpr float minCutoff = 20.0f, maxCutoff = 20000.0f;
+
+    explicit DspTables (double sampleRate);
+
+    double sampleRate;
+    float sineTable[sineSize + 1];      // sin (2 pi x), x in [0, 1], guard point at the end
+    float noteHz[128];                  // equal-tempered MIDI note frequencies
+    float prewarpTable[prewarpSize + 1]; // TPT g = tan (pi fc / fs), fc log-spaced over [minCutoff, maxCutoff]
+    float log2MinCutoff, log2MaxCutoff;
+
+    // phase01 in [0, 1)
+    inline float sine (double phase01) const {
+        const double x = phase01 * sineSize;
+        const int i = (int) x; const float frac = (float) (x - i);
+        return sineTable[i] + frac * (sineTable[i + 1] - sineTable[i]);
+    }
+
+    // Prewarped SVF gain for a cutoff given as log2 (Hz); clamped to the table range.
+    inline float prewarpLog2 (float log2Hz) const {
+        const float x = (juce::jlimit (log2MinCutoff, log2MaxCutoff, log2Hz) - log2MinCutoff)
+                        * ((float) prewarpSize / (log2MaxCutoff - log2MinCutoff));
+        const int i = juce::jmin ((int) x, prewarpSize - 1); const float frac = x - (float) i;
+        return prewarpTable[i] + frac * (prewarpTable[i + 1] - prewarpTable[i]);
+    }
+};
+
+namespace SharedTables {
+    // Message thread (prepareToPlay). Returns the process-wide tables for this rate,
+    // building them on first use; keep the pointer for as long as voices use them.
+    std::shared_ptr<const DspTables> acquire (double sampleRate);
+}
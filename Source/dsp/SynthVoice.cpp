@@ -9,229 +9,372 @@
 */
 
 #include "SynthVoice.h"
-#include "../PluginProcessor.h"
+#include "NoteCache.h"
+#include "diag/TraceRecorder.h"
+#include <algorithm>
+#include <cstring>
 
 using namespace juce;
 using namespace juce::dsp;
 
-static inline float noteHz (int midi) { return (float) MidiMessage::getMidiNoteInHertz (midi); }
+namespace {
+// Rational (Pade) tanh, exact +-1 at |x| = 3: the eco tier's stand-in for std::tanh
+inline float fastTanh (float x) { x = jlimit (-3.0f, 3.0f, x); return x * (27.0f + x * x) / (27.0f + 9.0f * x * x); }
+
+// 2^x as 2^round(x) (exponent bits) times a degree-5 Taylor polynomial on [-0.5, 0.5]:
+// within 3.3e-6 relative (0.006 cent), for the per-tick LFO pitch factor
+inline float fastExp2 (float x) {
+    x = jlimit (-126.0f, 127.0f, x);
+    const int n = (int) (x + (x < 0.0f ? -0.5f : 0.5f)); // truncating conversion, no libm call
+    const float f = x - (float) n;
+    const float p = 1.0f + f * (0.693147181f + f * (0.240226507f + f * (0.0555041087f + f * (0.00961812911f + f * 0.00133335581f))));
+    const int32 bits = (n + 127) << 23;
+    float scale; std::memcpy (&scale, &bits, sizeof (scale));
+    return p * scale;
+}
+
+// Internal wave index past the last waveChoices entry: the oscillator's user table
+constexpr int tableWave = 8;
+}
 
-SynthVoice::SynthVoice (AudioProcessorValueTreeState& s) : state (s) {}
+// Layout guards: voices sit back to back in a VoiceArena, hot state first
+static_assert (alignof (SynthVoice) == 64, "each voice must start on a cache line");
+static_assert (sizeof (SynthVoice) <= 34 * 64, "voice grew: hot state plus the 1 KB event queue should fit in 34 cache lines");
 
-bool SynthVoice::canPlaySound (SynthesiserSound* snd) { return dynamic_cast<SynthSound*> (snd) != nullptr; }
+SynthVoice::SynthVoice (const params::Block& block) : p (block) {}
 
-void SynthVoice::prepare (double sr, int spb, int numCh) {
+void SynthVoice::prepare (double sr, int spb, int numCh, const DspTables& sharedTables) {
     sampleRate = sr;
+    hot.tables = &sharedTables;
+
+    maxChunk = jmax (1, spb);
     ProcessSpec spec{ sampleRate, (uint32) spb, (uint32) jmax (1, numCh) };
 
     for (int i = 0; i < unisonVoices; ++i) {
-        osc1[i].initialise ([](float x){ return std::sin (x); }, 128);
-        osc2[i].initialise ([](float x){ return std::sin (x); }, 128);
-        osc3[i].initialise ([](float x){ return std::sin (x); }, 128);
-        osc1[i].prepare (spec); osc2[i].prepare (spec); osc3[i].prepare (spec);
-        pulse1[i].prepare (spec); pulse2[i].prepare (spec); pulse3[i].prepare (spec);
-        blep1[i].prepare  (spec); blep2[i].prepare  (spec); blep3[i].prepare  (spec);
+        hot.osc1[i].prepare (*hot.tables); hot.osc2[i].prepare (*hot.tables); hot.osc3[i].prepare (*hot.tables);
+        hot.pulse1[i].prepare (spec); hot.pulse2[i].prepare (spec); hot.pulse3[i].prepare (spec);
+        hot.blep1[i].prepare  (spec); hot.blep2[i].prepare  (spec); hot.blep3[i].prepare  (spec);
     }
-    subSine.prepare (spec); subTri.prepare (spec); subPulse.prepare (spec); noise.prepare (spec);
+    hot.subSine.prepare (*hot.tables); hot.subTri.prepare (*hot.tables); hot.subPulse.prepare (spec); hot.noise.prepare (spec);
+
+    hot.filter.reset();
 
-    filterL.prepare (spec); filterR.prepare (spec);
+    hot.ampEnv.setSampleRate (sampleRate);
+    hot.filtEnv.setSampleRate (sampleRate);
 
-    ampEnv.setSampleRate (sampleRate);
-    filtEnv.setSampleRate (sampleRate);
+    hot.lfo1.prepare (*hot.tables); hot.lfo2.prepare (*hot.tables);
+    hot.pwmLfo1.prepare (*hot.tables); hot.pwmLfo2.prepare (*hot.tables); hot.pwmLfo3.prepare (*hot.tables);
 
-    lfo1.prepare (spec); lfo2.prepare (spec);
-    pwmLfo1.prepare (spec); pwmLfo2.prepare (spec); pwmLfo3.prepare (spec);
+    // ~5 ms one-pole on expression, stepped at control rate
+    hot.smoothCoeff = (float) (1.0 - std::exp (-controlInterval / (0.005 * sampleRate)));
 
+    dropFrozen();
     updateStaticParams();
 }
 
-void SynthVoice::startNote (int midi, float vel, SynthesiserSound*, int) {
-    baseFreqHz = noteHz (midi);
-    curVelocity = jlimit (0.0f, 1.0f, vel);
-    pitchBendSemitones = 0.0f; aftertouch = 0.0f; channelPressure = 0.0f;
-    ampEnv.noteOn(); filtEnv.noteOn();
+bool SynthVoice::queueEvent (const Event& e) {
+    const bool noteEnd = e.type == Event::NoteOff || e.type == Event::Kill;
+    bool lost = false;
+    if (hot.numEvents == maxEvents) lost = ! makeRoom (noteEnd);
+    if (hot.numEvents < maxEvents) { events[hot.numEvents++] = e; return ! lost; }
+
+    // Still full of note events, more than a chunk can play: a note end takes the
+    // newest slot, anything else is lost
+    MS_TRACE_INSTANT ("eventDropped", "voice", e.type);
+    if (noteEnd) events[maxEvents - 1] = e;
+    return false;
+}
+
+bool SynthVoice::makeRoom (bool forNoteEnd) {
+    // Expression values a later event of the same type overrides go first: only the
+    // smoothing path towards the newer target changes
+    uint32 later = 0; // expression types seen after events[i]
+    int kept = maxEvents;
+    for (int i = hot.numEvents; --i >= 0;) {
+        if (events[i].type > Event::Kill) {
+            const uint32 bit = 1u << events[i].type;
+            if ((later & bit) != 0) continue;
+            later |= bit;
+        }
+        events[--kept] = events[i];
+    }
+    std::copy (events + kept, events + maxEvents, events);
+    hot.numEvents = maxEvents - kept;
+    if (hot.numEvents < maxEvents || ! forNoteEnd) return true;
+
+    // Every event distinct: a note end matters more than the newest expression value
+    for (int i = hot.numEvents; --i >= 0;)
+        if (events[i].type > Event::Kill) {
+            MS_TRACE_INSTANT ("eventDropped", "voice", events[i].type);
+            std::copy (events + i + 1, events + hot.numEvents, events + i);
+            --hot.numEvents;
+            return false;
+        }
+    return true;
+}
+
+void SynthVoice::applyEvent (const Event& e) {
+    switch (e.type) {
+        case Event::NoteOn:          startNote (e.note, e.value); break;
+        case Event::FrozenNoteOn:    startNote (e.note, e.value); frozen = pendingFrozen; pendingFrozen = nullptr; frozenPos = 0; break;
+        case Event::NoteOff:         stopNote (true); break;
+        case Event::Kill:            stopNote (false); break;
+        case Event::NoteBend:        hot.target.noteBend   = e.value; break;
+        case Event::MasterBend:      hot.target.masterBend = e.value; break;
+        case Event::Pressure:        hot.target.pressure   = e.value; break;
+        case Event::Timbre:          hot.target.timbre     = e.value; break;
+    }
 }
 
-void SynthVoice::stopNote (float, bool tail) {
-    ampEnv.noteOff(); filtEnv.noteOff();
-    if (! tail || ! ampEnv.isActive()) clearCurrentNote();
+void SynthVoice::startNote (int midi, float /*velocity: not used by the voice*/) {
+    MS_TRACE_INSTANT ("startNote", "voice", midi);
+    dropFrozen();
+    currentNote = midi;
+    const auto& t = tuning != nullptr ? tuning->current() : TuningTable::equal();
+    hot.baseFreqHz = t.hz[jlimit (0, 127, midi)];
+    hot.baseLog2Hz = t.log2Hz[jlimit (0, 127, midi)];
+    hot.current = hot.target; // initial expression is queued ahead of the note-on: no glide into it
+    hot.controlCountdown = 0;
+    updateStaticParams(); // pick up envelope changes (automation, presets, morph)
+    hot.ampEnv.noteOn(); hot.filtEnv.noteOn();
+    hot.sounding = true;
 }
 
-void SynthVoice::pitchWheelMoved (int v) {
-    const float range = state.getRawParameterValue (ids::bendRange)->load();
-    const float norm = (v - 8192) / 8192.0f;
-    pitchBendSemitones = norm * range;
+void SynthVoice::stopNote (bool tail) {
+    MS_TRACE_INSTANT (tail ? "stopNote" : "killNote", "voice", currentNote);
+    if (tail) { hot.ampEnv.noteOff(); hot.filtEnv.noteOff(); }
+    else      { hot.ampEnv.reset(); hot.filtEnv.reset(); }
+    if (! hot.ampEnv.isActive()) hot.sounding = false;
 }
-void SynthVoice::channelPressureChanged (int v) { channelPressure = jlimit (0.0f, 1.0f, v / 127.0f); }
-void SynthVoice::aftertouchChanged      (int v) { aftertouch      = jlimit (0.0f, 1.0f, v / 127.0f); }
-void SynthVoice::controllerMoved (int /*controllerNumber*/, int /*newControllerValue*/)
-{
-    // No-op for now. You can map CC1 (mod wheel), CC11, etc. to parameters here.
+
+void SynthVoice::updateExpression() {
+    hot.current.noteBend   += hot.smoothCoeff * (hot.target.noteBend   - hot.current.noteBend);
+    hot.current.masterBend += hot.smoothCoeff * (hot.target.masterBend - hot.current.masterBend);
+    hot.current.pressure   += hot.smoothCoeff * (hot.target.pressure   - hot.current.pressure);
+    hot.current.timbre     += hot.smoothCoeff * (hot.target.timbre     - hot.current.timbre);
+    hot.pitchHz = std::exp2 (hot.baseLog2Hz + (hot.current.noteBend + hot.current.masterBend) / 12.0f);
 }
+
 void SynthVoice::updateStaticParams() {
-    ampEnv.setParameters ({ state.getRawParameterValue (ids::attack )->load(),
-                            state.getRawParameterValue (ids::decay  )->load(),
-                            state.getRawParameterValue (ids::sustain)->load(),
-                            state.getRawParameterValue (ids::release)->load() });
-
-    filtEnv.setParameters ({ state.getRawParameterValue (ids::fA)->load(),
-                             state.getRawParameterValue (ids::fD)->load(),
-                             state.getRawParameterValue (ids::fS)->load(),
-                             state.getRawParameterValue (ids::fR)->load() });
+    hot.ampEnv.setParameters ({ p[params::idx::attack],
+                            p[params::idx::decay],
+                            p[params::idx::sustain],
+                            p[params::idx::release] });
+
+    hot.filtEnv.setParameters ({ p[params::idx::fA],
+                             p[params::idx::fD],
+                             p[params::idx::fS],
+                             p[params::idx::fR] });
 }
 
 void SynthVoice::updateDynamicParams() {
-    lfo1.setFrequency (state.getRawParameterValue (ids::lfoRate )->load());
-    lfo2.setFrequency (state.getRawParameterValue (ids::lfo2Rate)->load());
-    pwmLfo1.setFrequency (state.getRawParameterValue (ids::pwmRate1)->load());
-    pwmLfo2.setFrequency (state.getRawParameterValue (ids::pwmRate2)->load());
-    pwmLfo3.setFrequency (state.getRawParameterValue (ids::pwmRate3)->load());
+    hot.lfo1.setFrequency (p[params::idx::lfoRate]);
+    hot.lfo2.setFrequency (p[params::idx::lfo2Rate]);
+    hot.pwmLfo1.setFrequency (p[params::idx::pwmRate1]);
+    hot.pwmLfo2.setFrequency (p[params::idx::pwmRate2]);
+    hot.pwmLfo3.setFrequency (p[params::idx::pwmRate3]);
 }
 
 void SynthVoice::renderNextBlock (AudioBuffer<float>& output, int start, int n) {
-    if (! isVoiceActive()) return;
+    jassert (n <= maxChunk); // the processor renders in chunks of at most maxChunk
+    if (! isSounding()) return;
+    MS_TRACE_SCOPE ("voice", "voice", currentNote);
 
     updateDynamicParams();
 
-    temp.setSize (2, n, false, false, true); temp.clear();
-    float* L = temp.getWritePointer (0);
-    float* R = temp.getWritePointer (1);
-
-    const int  wave1i = (int) state.getRawParameterValue (ids::osc1Wave)->load();
-    const int  wave2i = (int) state.getRawParameterValue (ids::osc2Wave)->load();
-    const int  wave3i = (int) state.getRawParameterValue (ids::osc3Wave)->load();
-
-    const float mix1v = state.getRawParameterValue (ids::mix1)->load();
-    const float mix2v = state.getRawParameterValue (ids::mix2)->load();
-    const float mix3v = state.getRawParameterValue (ids::mix3)->load();
-
-    const float det1  = state.getRawParameterValue (ids::detune1)->load();
-    const float det2  = state.getRawParameterValue (ids::detune2)->load();
-    const float det3  = state.getRawParameterValue (ids::detune3)->load();
-
-    const bool  uniOn = state.getRawParameterValue (ids::uniOn)->load() > 0.5f;
-    const float uniDet= state.getRawParameterValue (ids::uniDetune)->load();
-    const float spread= state.getRawParameterValue (ids::stereoSpread)->load();
-
-    const float pwm1B = state.getRawParameterValue (ids::pwm1)->load();
-    const float pwm2B = state.getRawParameterValue (ids::pwm2)->load();
-    const float pwm3B = state.getRawParameterValue (ids::pwm3)->load();
-    const float pwmD1 = state.getRawParameterValue (ids::pwmDepth1)->load();
-    const float pwmD2 = state.getRawParameterValue (ids::pwmDepth2)->load();
-    const float pwmD3 = state.getRawParameterValue (ids::pwmDepth3)->load();
-
-    const int subWave = (int) state.getRawParameterValue (ids::subWave)->load();
-    const int subOct  = (int) state.getRawParameterValue (ids::subOct )->load();
-    const bool subOn  = state.getRawParameterValue (ids::subOn)->load() > 0.5f;
-    const float subLvl= state.getRawParameterValue (ids::subLevel)->load();
-
-    const float nW = state.getRawParameterValue (ids::mixNoiseW)->load();
-    const float nP = state.getRawParameterValue (ids::mixNoiseP)->load();
-    const float nB = state.getRawParameterValue (ids::mixNoiseB)->load();
-    const bool nHPFon = state.getRawParameterValue (ids::noiseHPFOn)->load() > 0.5f;
-    const float nHPFhz = state.getRawParameterValue (ids::noiseHPF)->load();
-
-    const int fType = (int) state.getRawParameterValue (ids::filterType)->load();
-    const float cutoff = state.getRawParameterValue (ids::cutoff)->load();
-    const float q      = state.getRawParameterValue (ids::resonance)->load();
-    const float fAmt   = state.getRawParameterValue (ids::fAmt)->load();
-
-    const float lfo1Dp = state.getRawParameterValue (ids::lfoDepth)->load();
-    const int   lfo1Tg = (int) state.getRawParameterValue (ids::lfoTarget)->load();
-    const float lfo2Dp = state.getRawParameterValue (ids::lfo2Depth)->load();
-    const int   lfo2Tg = (int) state.getRawParameterValue (ids::lfo2Target)->load();
-
-    filterL.setType ((fType==0)? StateVariableTPTFilterType::lowpass
-                   : (fType==1)? StateVariableTPTFilterType::bandpass
-                               : StateVariableTPTFilterType::highpass);
-    filterR.setType ((fType==0)? StateVariableTPTFilterType::lowpass
-                   : (fType==1)? StateVariableTPTFilterType::bandpass
-                               : StateVariableTPTFilterType::highpass);
-
-    const float bendRatio = std::pow (2.0f, pitchBendSemitones / 12.0f);
-    const float gLin = Decibels::decibelsToGain (state.getRawParameterValue (ids::gain)->load());
+    // Mixed straight into the caller's buffer: no per-voice scratch to stream through the cache
+    jassert (output.getNumChannels() == 1 || output.getNumChannels() == 2);
+    float* L = output.getWritePointer (0, start);
+    float* R = output.getNumChannels() > 1 ? output.getWritePointer (1, start) : nullptr;
+
+    // A loaded user table replaces the wave while its oscillator's Table switch is on
+    const Wavetable* table1 = userTables != nullptr ? userTables->osc[0] : nullptr;
+    const Wavetable* table2 = userTables != nullptr ? userTables->osc[1] : nullptr;
+    const Wavetable* table3 = userTables != nullptr ? userTables->osc[2] : nullptr;
+    const float tPos1 = p[params::idx::tablePos1];
+    const float tPos2 = p[params::idx::tablePos2];
+    const float tPos3 = p[params::idx::tablePos3];
+
+    const int  wave1i = table1 != nullptr && p[params::idx::tableOn1] > 0.5f ? tableWave : (int) p[params::idx::osc1Wave];
+    const int  wave2i = table2 != nullptr && p[params::idx::tableOn2] > 0.5f ? tableWave : (int) p[params::idx::osc2Wave];
+    const int  wave3i = table3 != nullptr && p[params::idx::tableOn3] > 0.5f ? tableWave : (int) p[params::idx::osc3Wave];
+
+    const float mix1v = p[params::idx::mix1];
+    const float mix2v = p[params::idx::mix2];
+    const float mix3v = p[params::idx::mix3];
+
+    // Detune and unison spread as frequency ratios, once per block
+    const float detR1 = std::exp2 (p[params::idx::detune1] / 12.0f);
+    const float detR2 = std::exp2 (p[params::idx::detune2] / 12.0f);
+    const float detR3 = std::exp2 (p[params::idx::detune3] / 12.0f);
+
+    const bool  uniOn = p[params::idx::uniOn] > 0.5f;
+    const float uniUp = std::exp2 (p[params::idx::uniDetune] / 1200.0f), uniDown = 1.0f / uniUp;
+    const float spread= p[params::idx::stereoSpread];
+
+    const float pwm1B = p[params::idx::pwm1];
+    const float pwm2B = p[params::idx::pwm2];
+    const float pwm3B = p[params::idx::pwm3];
+    const float pwmD1 = p[params::idx::pwmDepth1];
+    const float pwmD2 = p[params::idx::pwmDepth2];
+    const float pwmD3 = p[params::idx::pwmDepth3];
+
+    const int subWave = (int) p[params::idx::subWave];
+    const int subOct  = (int) p[params::idx::subOct];
+    const bool subOn  = p[params::idx::subOn] > 0.5f;
+    const float subLvl= p[params::idx::subLevel];
+
+    const float nW = p[params::idx::mixNoiseW];
+    const float nP = p[params::idx::mixNoiseP];
+    const float nB = p[params::idx::mixNoiseB];
+    const bool nHPFon = p[params::idx::noiseHPFOn] > 0.5f;
+    const float nHPFhz = p[params::idx::noiseHPF];
+    const float nHPFa = juce::jlimit (0.0f, 0.999f, nHPFhz / (nHPFhz + (float) sampleRate));
+
+    const int fType = (int) p[params::idx::filterType];
+    const float cutoff = p[params::idx::cutoff];
+    const float q      = p[params::idx::resonance];
+    const float fAmt   = p[params::idx::fAmt];
+
+    const float lfo1Dp = p[params::idx::lfoDepth];
+    const int   lfo1Tg = (int) p[params::idx::lfoTarget];
+    const float lfo2Dp = p[params::idx::lfo2Depth];
+    const int   lfo2Tg = (int) p[params::idx::lfo2Target];
+    const bool  lfo1Tb = p[params::idx::lfo1Table] > 0.5f;
+    const bool  lfo2Tb = p[params::idx::lfo2Table] > 0.5f;
+
+    // LFO pitch modulation in octaves per unit of LFO output
+    const float lfo1Oct = lfo1Tg == 1 ? 0.1f * lfo1Dp : 0.0f;
+    const float lfo2Oct = lfo2Tg == 1 ? 0.05f * lfo2Dp : 0.0f;
+    const bool lfoPitch = lfo1Oct != 0.0f || lfo2Oct != 0.0f;
+
+    hot.filter.setType ((fType==0)? TptSvf::lowpass
+                  : (fType==1)? TptSvf::bandpass
+                              : TptSvf::highpass);
+    const float log2Cutoff = std::log2 (cutoff);
+
+    const float gLin = Decibels::decibelsToGain (p[params::idx::gain]);
+
+    // Events are applied at their sample offset inside this single pass, so dense
+    // bend/pressure streams no longer split the render into fragments.
+    int ev = 0;
+    int nextEventAt = hot.numEvents > 0 ? events[0].offset : n;
+
+    // Pitch and cutoff modulation are recomputed every quality.modInterval samples (1 = per sample)
+    const bool cheap = quality.cheapShapes;
+    const bool unison = uniOn && quality.unison;
+    int modCountdown = 0;
+    float f1 = 0.0f, f2 = 0.0f, f3 = 0.0f, amp = 0.0f;
 
     for (int i = 0; i < n; ++i) {
-        const float lfo1v = lfo1.processSample (0.0f); // -1..1
-        const float lfo2v = lfo2.processSample (0.0f);
+        while (i == nextEventAt) {
+            applyEvent (events[ev++]);
+            nextEventAt = ev < hot.numEvents ? events[ev].offset : n;
+        }
+        if (! hot.sounding) { i = nextEventAt - 1; continue; } // idle until the next event
+        if (frozen != nullptr) { i = renderFrozen (L, R, i, nextEventAt, amp) - 1; continue; } // stored render: envelope only
+
+        if (--hot.controlCountdown < 0) { hot.controlCountdown = controlInterval - 1; updateExpression(); }
+
+        const float lfo1v = hot.lfo1.processSample(); // -1..1
+        const float lfo2v = hot.lfo2.processSample();
 
-        float f1 = baseFreqHz * bendRatio * std::pow (2.0f, det1 / 12.0f);
-        float f2 = baseFreqHz * bendRatio * std::pow (2.0f, det2 / 12.0f);
-        float f3 = baseFreqHz * bendRatio * std::pow (2.0f, det3 / 12.0f);
+        const bool modTick = --modCountdown < 0;
+        if (modTick) {
+            modCountdown = quality.modInterval - 1;
+            // Bent pitch comes from the control-rate update; an LFO on pitch adds a polynomial exp2
+            const float pitch = lfoPitch ? hot.pitchHz * fastExp2 (lfo1Oct * lfo1v + lfo2Oct * lfo2v) : hot.pitchHz;
+            f1 = pitch * detR1; f2 = pitch * detR2; f3 = pitch * detR3;
+        }
 
-        if (lfo1Tg == 1) { f1 *= std::pow (2.0f, 0.1f * lfo1Dp * lfo1v); f2 *= std::pow (2.0f, 0.1f * lfo1Dp * lfo1v); f3 *= std::pow (2.0f, 0.1f * lfo1Dp * lfo1v); }
-        if (lfo2Tg == 1) { f1 *= std::pow (2.0f, 0.05f * lfo2Dp * lfo2v); f2 *= std::pow (2.0f, 0.05f * lfo2Dp * lfo2v); f3 *= std::pow (2.0f, 0.05f * lfo2Dp * lfo2v); }
+        const float pw1 = juce::jlimit (0.05f, 0.95f, pwm1B + pwmD1 * hot.pwmLfo1.processSample());
+        const float pw2 = juce::jlimit (0.05f, 0.95f, pwm2B + pwmD2 * hot.pwmLfo2.processSample());
+        const float pw3 = juce::jlimit (0.05f, 0.95f, pwm3B + pwmD3 * hot.pwmLfo3.processSample());
 
-        const float pw1 = juce::jlimit (0.05f, 0.95f, pwm1B + pwmD1 * pwmLfo1.processSample (0.0f));
-        const float pw2 = juce::jlimit (0.05f, 0.95f, pwm2B + pwmD2 * pwmLfo2.processSample (0.0f));
-        const float pw3 = juce::jlimit (0.05f, 0.95f, pwm3B + pwmD3 * pwmLfo3.processSample (0.0f));
+        // Frame position: an LFO switched to Table sweeps +-depth/2 around each oscillator's setting
+        const float tMod = (lfo1Tb ? 0.5f * lfo1Dp * lfo1v : 0.0f) + (lfo2Tb ? 0.5f * lfo2Dp * lfo2v : 0.0f);
 
-        auto oscSample = [&](int wave, float freq, float pw, PulseOsc& pulse, PolyBLEPOsc& blep, Oscillator<float>& sinGen){
+        auto oscSample = [&](int wave, float freq, float pw, PulseOsc& pulse, PolyBLEPOsc& blep, TableOsc& sinGen, const Wavetable* table, float tPos){
             float s = 0.0f;
             switch (wave) {
-                case 0: sinGen.setFrequency (freq); s = sinGen.processSample (0.0f); break;                   // Sine
+                case 0: sinGen.setFrequency (freq); s = sinGen.processSample(); break;                   // Sine
                 case 1: blep.setMode (PolyBLEPOsc::SawUp);   blep.setFrequency (freq); s = blep.processSample(); break; // Saw+
                 case 5: blep.setMode (PolyBLEPOsc::SawDown); blep.setFrequency (freq); s = blep.processSample(); break; // Saw-
                 case 2: pulse.setFrequency (freq); pulse.setPulseWidth (pw); s = pulse.processSample(); break;          // Pulse
-                case 3: sinGen.setFrequency (freq); s = (2.0f/MathConstants<float>::pi) * std::asin (sinGen.processSample (0.0f)); break; // Tri via arcsin(sin)
-                case 4: s = noise.white(); break;                                                 // White noise as OSC
-                case 6: sinGen.setFrequency (freq); s = std::tanh (2.0f * sinGen.processSample (0.0f)); break;          // Folded sine
-                case 7: sinGen.setFrequency (freq); s = juce::jlimit (-1.0f, 1.0f, sinGen.processSample (0.0f) * 0.5f + 0.5f); break; // Half-sine
-                default: sinGen.setFrequency (freq); s = sinGen.processSample (0.0f); break;
+                case 3: sinGen.setFrequency (freq);                                                            // Tri via arcsin(sin)
+                        s = cheap ? sinGen.processTriangle() : (2.0f/MathConstants<float>::pi) * std::asin (sinGen.processSample()); break;
+                case 4: s = hot.noise.white(); break;                                                 // White noise as OSC
+                case 6: sinGen.setFrequency (freq);                                                            // Folded sine
+                        s = cheap ? fastTanh (2.0f * sinGen.processSample()) : std::tanh (2.0f * sinGen.processSample()); break;
+                case 7: sinGen.setFrequency (freq); s = juce::jlimit (-1.0f, 1.0f, sinGen.processSample() * 0.5f + 0.5f); break; // Half-sine
+                case tableWave: sinGen.setFrequency (freq); s = sinGen.processWavetable (*table, tPos + tMod); break;   // User table
+                default: sinGen.setFrequency (freq); s = sinGen.processSample(); break;
             }
             return s;
         };
 
-        float s1 = oscSample (wave1i, f1, pw1, pulse1[0], blep1[0], osc1[0]);
-        float s2 = oscSample (wave2i, f2, pw2, pulse2[0], blep2[0], osc2[0]);
-        float s3 = oscSample (wave3i, f3, pw3, pulse3[0], blep3[0], osc3[0]);
+        float s1 = oscSample (wave1i, f1, pw1, hot.pulse1[0], hot.blep1[0], hot.osc1[0], table1, tPos1);
+        float s2 = oscSample (wave2i, f2, pw2, hot.pulse2[0], hot.blep2[0], hot.osc2[0], table2, tPos2);
+        float s3 = oscSample (wave3i, f3, pw3, hot.pulse3[0], hot.blep3[0], hot.osc3[0], table3, tPos3);
 
-        if (uniOn) {
-            s1 = 0.5f * (s1 + oscSample (wave1i, f1 * std::pow (2.0f,  uniDet / 1200.0f), pw1, pulse1[1], blep1[1], osc1[1]));
-            s2 = 0.5f * (s2 + oscSample (wave2i, f2 * std::pow (2.0f, -uniDet / 1200.0f), pw2, pulse2[1], blep2[1], osc2[1]));
-            s3 = 0.5f * (s3 + oscSample (wave3i, f3 * std::pow (2.0f,  uniDet / 1200.0f), pw3, pulse3[1], blep3[1], osc3[1]));
+        if (unison) {
+            s1 = 0.5f * (s1 + oscSample (wave1i, f1 * uniUp, pw1, hot.pulse1[1], hot.blep1[1], hot.osc1[1], table1, tPos1));
+            s2 = 0.5f * (s2 + oscSample (wave2i, f2 * uniDown, pw2, hot.pulse2[1], hot.blep2[1], hot.osc2[1], table2, tPos2));
+            s3 = 0.5f * (s3 + oscSample (wave3i, f3 * uniUp, pw3, hot.pulse3[1], hot.blep3[1], hot.osc3[1], table3, tPos3));
         }
 
         float sub = 0.0f;
         if (subOn) {
-            const float subF = baseFreqHz * (subOct == 0 ? 0.5f : 0.25f);
-            if (subWave == 0) { subSine.setFrequency (subF); sub = subSine.processSample (0.0f); }
-            else if (subWave == 1) { subPulse.setFrequency (subF); subPulse.setPulseWidth (0.5f); sub = subPulse.processSample(); }
-            else { subTri.setFrequency (subF); sub = subTri.processSample (0.0f); }
+            const float subF = hot.baseFreqHz * (subOct == 0 ? 0.5f : 0.25f);
+            if (subWave == 0) { hot.subSine.setFrequency (subF); sub = hot.subSine.processSample(); }
+            else if (subWave == 1) { hot.subPulse.setFrequency (subF); hot.subPulse.setPulseWidth (0.5f); sub = hot.subPulse.processSample(); }
+            else { hot.subTri.setFrequency (subF); sub = cheap ? hot.subTri.processTriangle() : (2.0f/MathConstants<float>::pi) * std::asin (hot.subTri.processSample()); }
         }
 
-        float noi = nW * noise.white() + nP * noise.pink() + nB * noise.brown();
-        if (nHPFon) {
-            const float a = juce::jlimit (0.0f, 0.999f, nHPFhz / (nHPFhz + (float) sampleRate));
-            noi = noise.highpass (noi, a);
-        }
+        float noi = nW * hot.noise.white() + nP * hot.noise.pink() + nB * hot.noise.brown();
+        if (nHPFon) noi = hot.noise.highpass (noi, nHPFa);
 
         float dry = mix1v * s1 + mix2v * s2 + mix3v * s3 + subLvl * sub + noi;
 
-        float amp = ampEnv.getNextSample();
+        amp = hot.ampEnv.getNextSample();
         if (lfo1Tg == 2) amp *= juce::jlimit (0.0f, 2.0f, 1.0f + lfo1Dp * 0.5f * lfo1v);
         if (lfo2Tg == 2) amp *= juce::jlimit (0.0f, 2.0f, 1.0f + lfo2Dp * 0.5f * lfo2v);
+        amp *= 1.0f + 0.5f * hot.current.pressure;
 
-        const float envF = filtEnv.getNextSample();
-        const float modCut = cutoff * std::pow (2.0f, fAmt * (envF - 0.5f));
-        filterL.setCutoffFrequency (juce::jlimit (20.0f, 20000.0f, modCut));
-        filterR.setCutoffFrequency (juce::jlimit (20.0f, 20000.0f, modCut));
-        filterL.setResonance (q); filterR.setResonance (q);
+        // cutoff * 2^(fAmt * (env - 0.5) + 2 * timbre), clamped to 20..20k Hz, in the log domain
+        const float envF = hot.filtEnv.getNextSample();
+        if (modTick) hot.filter.setCoefficients (hot.tables->prewarpLog2 (log2Cutoff + fAmt * (envF - 0.5f) + 2.0f * hot.current.timbre), q);
 
         // simple pan from spread (0..1)
         const float panL = 0.5f - 0.5f * spread;
         const float panR = 0.5f + 0.5f * spread;
 
-        float l = filterL.processSample (0, dry) * amp * panL * gLin;
-        float r = filterR.processSample (1, dry) * amp * panR * gLin;
+        float l = hot.filter.processSample (0, dry) * amp * panL * gLin;
+        float r = hot.filter.processSample (1, dry) * amp * panR * gLin;
+
+        L[i] += l; if (R != nullptr) R[i] += r;
 
-        L[i] += l; R[i] += r;
+        if (! hot.ampEnv.isActive()) hot.sounding = false; // release finished: voice is free
     }
+    hot.numEvents = 0;
+    hot.level = amp;
+    if (! hot.sounding) dropFrozen();
+    if (pendingFrozen != nullptr) { pendingFrozen->release(); pendingFrozen = nullptr; } // its note-on was folded away
+}
 
-    // Sum into output
-    for (int ch = 0; ch < output.getNumChannels(); ++ch) {
-        auto* dst = output.getWritePointer (ch, start);
-        auto* src = temp.getReadPointer (jmin (ch, 1));
-        for (int i = 0; i < n; ++i) dst[i] += src[i];
+// Plays the stored render from frozenPos over [i, end) through the amp envelope; returns where it stopped
+int SynthVoice::renderFrozen (float* L, float* R, int i, int end, float& amp) noexcept {
+    const float* a = frozen->channel (0);
+    const float* b = frozen->channel (1);
+    for (; i < end; ++i, ++frozenPos) {
+        if (frozenPos >= frozen->length || ! hot.ampEnv.isActive()) { hot.sounding = false; break; }
+        amp = hot.ampEnv.getNextSample();
+        L[i] += a[frozenPos] * amp; if (R != nullptr) R[i] += b[frozenPos] * amp;
     }
+    return i;
+}
+
+void SynthVoice::dropFrozen() noexcept {
+    if (frozen != nullptr) frozen->release();
+    frozen = nullptr;
 }
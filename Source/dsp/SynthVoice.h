@@ -4,8 +4,9 @@
     Revision: 1.0.0
     Date: 2025-08-19
     Description:
-        Voice class for the polyphonic Synthesiser. Hosts oscillators, sub,
-        noise, envelopes, filters, and LFOs. Renders audio per voice.
+        Voice class for the polyphonic VoiceManager. Hosts oscillators, sub,
+        noise, envelopes, filters, and LFOs. Renders audio per voice, applying
+        timestamped note and per-note expression events inside a single pass.
 */
 
 #pragma once
@@ -13,52 +14,115 @@
 #include "Noise.h"
 #include "PulseOsc.h"
 #include "PolyBLEPOsc.h"
+#include "TableOsc.h"
+#include "TptSvf.h"
+#include "Tuning.h"
+#include "ParameterSpecs.h"
 
-class SynthVoice : public juce::SynthesiserVoice {
+struct FrozenNote; // NoteCache.h
+
+class SynthVoice {
 public:
-    explicit SynthVoice (juce::AudioProcessorValueTreeState& stateRef);
+    explicit SynthVoice (const params::Block& paramBlock);
+
+    // maxChunk: largest span renderNextBlock will render at once (the processor's chunk size)
+    void prepare (double sampleRate, int maxChunk, int numChannels, const DspTables& sharedTables);
+
+    // Queued by the VoiceManager before rendering; offset is relative to the start of
+    // the next renderNextBlock call and events must arrive in offset order. When the queue
+    // is full, expression values a later one overrides are merged away first, and note-offs
+    // and kills are kept in preference to expression. Returns false if an event was lost.
+    struct Event {
+        enum Type : juce::uint8 { NoteOn, FrozenNoteOn, NoteOff, Kill, NoteBend, MasterBend, Pressure, Timbre };
+        int offset; Type type; int note; float value; // velocity, bend in semitones, pressure 0..1, timbre -1..1
+    };
+    bool queueEvent (const Event& e);
+
+    // Adds the voice into a mono or stereo 'output' (no scratch buffer of its own)
+    void renderNextBlock (juce::AudioBuffer<float>& output, int startSample, int numSamples);
+    bool isSounding() const { return hot.sounding || hot.numEvents > 0; }
+
+    void setNoiseSeed (juce::int64 seed) { hot.noise.seed (seed); }
 
-    bool canPlaySound (juce::SynthesiserSound* sound) override;
+    // Owner's per-block user wavetables; an oscillator with no table plays its wave
+    void setUserTables (const UserTables* t) { userTables = t; }
 
-    void prepare (double sampleRate, int samplesPerBlock, int numChannels);
-    void startNote (int midiNoteNumber, float velocity, juce::SynthesiserSound*, int) override;
-    void stopNote (float, bool allowTailOff) override;
+    // Owner's tuning, read at note-on; null = 12-TET
+    void setTuning (const TuningSlot* t) { tuning = t; }
 
-    void pitchWheelMoved (int value) override;
-    void channelPressureChanged (int value) override;
-    void aftertouchChanged (int value) override;
-    void controllerMoved (int controllerNumber, int newControllerValue) override;
-    void renderNextBlock (juce::AudioBuffer<float>& output, int startSample, int numSamples) override;
+    // Freeze: the next FrozenNoteOn event plays this held render through the amp envelope
+    // instead of running the oscillators and filter. The voice releases it when done.
+    void setPendingFrozen (const FrozenNote* n) { pendingFrozen = n; }
+    bool hasPendingFrozen() const { return pendingFrozen != nullptr; }
+
+    // Render cost settings, lowered step by step by the eco governor. Defaults = full quality.
+    struct Quality {
+        bool unison = true;      // second oscillator copy when the patch has unison on
+        bool cheapShapes = false; // naive Tri, rational tanh for Fold, instead of asin / tanh
+        int modInterval = 1;     // samples between pitch / cutoff modulation updates
+    };
+    void setQuality (const Quality& q) { quality = q; quality.modInterval = juce::jmax (1, q.modInterval); }
+
+    // Amp envelope level at the end of the last render (0 when idle), to pick voices to shed
+    float getLevel() const { return isSounding() ? hot.level : 0.0f; }
 
 private:
+    void applyEvent (const Event& e);
+    bool makeRoom (bool forNoteEnd); // full queue; false if an event had to be dropped
+    void startNote (int midiNoteNumber, float velocity);
+    void stopNote (bool allowTailOff);
+    void updateExpression();
+    int renderFrozen (float* L, float* R, int from, int to, float& amp) noexcept;
+    void dropFrozen() noexcept;
+
     void updateStaticParams();
     void updateDynamicParams();
 
-    juce::AudioProcessorValueTreeState& state;
-
     static constexpr int unisonVoices = 2;
-    juce::dsp::Oscillator<float> osc1[unisonVoices], osc2[unisonVoices], osc3[unisonVoices];
-    PulseOsc    pulse1[unisonVoices], pulse2[unisonVoices], pulse3[unisonVoices];
-    PolyBLEPOsc blep1 [unisonVoices], blep2 [unisonVoices], blep3 [unisonVoices];
+    static constexpr int controlInterval = 16; // samples between expression smoothing steps
+
+    // Per-note expression: events set targets, smoothed every controlInterval samples
+    struct Expression { float noteBend = 0.0f, masterBend = 0.0f, pressure = 0.0f, timbre = 0.0f; };
 
-    juce::dsp::Oscillator<float> subSine { [](float x){ return std::sin (x); } };
-    juce::dsp::Oscillator<float> subTri  { [](float x){ return (2.0f/juce::MathConstants<float>::pi) * std::asin (std::sin (x)); } };
-    PulseOsc subPulse;
-    NoiseBus noise;
+    // Everything the per-sample loop reads or writes, packed from the first cache line
+    // of the voice: control state, then filter / envelopes / LFOs, then oscillators.
+    struct alignas (64) Hot {
+        bool sounding = false;
+        int numEvents = 0;
+        int controlCountdown = 0;
+        float level = 0.0f;
+        float baseFreqHz = 440.0f, baseLog2Hz = 8.78135971f; // from the tuning table at note-on
+        float smoothCoeff = 1.0f, pitchHz = 440.0f;           // base pitch with bend, at control rate
+        Expression target, current;
+        const DspTables* tables = nullptr; // process-wide, owned by SharedTables
 
-    juce::dsp::StateVariableTPTFilter<float> filterL, filterR;
+        TptSvf filter; // stereo: channel 0 = L, 1 = R
+        juce::ADSR ampEnv, filtEnv;
+        TableOsc lfo1, lfo2, pwmLfo1, pwmLfo2, pwmLfo3;
+        NoiseBus noise;
 
-    juce::ADSR ampEnv, filtEnv;
+        TableOsc    osc1  [unisonVoices], osc2  [unisonVoices], osc3  [unisonVoices];
+        PulseOsc    pulse1[unisonVoices], pulse2[unisonVoices], pulse3[unisonVoices];
+        PolyBLEPOsc blep1 [unisonVoices], blep2 [unisonVoices], blep3 [unisonVoices];
+        TableOsc subSine, subTri;
+        PulseOsc subPulse;
+    };
+    static_assert (sizeof (Hot) <= 16 * 64, "per-sample voice state should stay within 16 cache lines");
 
-    juce::dsp::Oscillator<float> lfo1 { [](float x){ return std::sin (x); } };
-    juce::dsp::Oscillator<float> lfo2 { [](float x){ return std::sin (x); } };
-    juce::dsp::Oscillator<float> pwmLfo1 { [](float x){ return std::sin (x); } };
-    juce::dsp::Oscillator<float> pwmLfo2 { [](float x){ return std::sin (x); } };
-    juce::dsp::Oscillator<float> pwmLfo3 { [](float x){ return std::sin (x); } };
+    Hot hot;
 
-    juce::AudioBuffer<float> temp;
+    // Cold: touched once per block or per event, kept behind the hot lines
+    const params::Block& p; // per-block values owned by the processor
+    const UserTables* userTables = nullptr;
+    const TuningSlot* tuning = nullptr;
+    const FrozenNote* frozen = nullptr;        // playing a stored render (see NoteCache)
+    const FrozenNote* pendingFrozen = nullptr;
+    int frozenPos = 0;
+    int currentNote = -1; // for traces
+    Quality quality;
+    int maxChunk = 64;
     double sampleRate = 44100.0;
-    float baseFreqHz = 440.0f, curVelocity = 1.0f;
 
-    float pitchBendSemitones = 0.0f, aftertouch = 0.0f, channelPressure = 0.0f;
+    static constexpr int maxEvents = 64;
+    Event events[maxEvents];
 };
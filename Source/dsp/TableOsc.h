@@ -0,0 +1,46 @@
+/*
+    File: TableOsc.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Sine oscillator reading the shared sine table. Replaces the per-object
+        juce::dsp::Oscillator (std::function + private lookup table) for the
+        main sine oscillators, sub and LFOs.
+*/
+
+#pragma once
+#include "SharedTables.h"
+#include "Wavetable.h"
+
+class TableOsc {
+public:
+    void prepare (const DspTables& t) { tables = &t; reset(); }
+    void reset() { phase = 0.0; }
+
+    void setFrequency (float hz) { incr = juce::jlimit (0.0, 0.45, hz / tables->sampleRate); }
+
+    float processSample() {
+        const float s = tables->sine (phase);
+        phase += incr; if (phase >= 1.0) phase -= 1.0;
+        return s;
+    }
+
+    // Naive triangle in phase with the sine (cheap, aliased): 0 at phase 0, +1 at 1/4
+    float processTriangle() {
+        double u = phase + 0.75; if (u >= 1.0) u -= 1.0;
+        phase += incr; if (phase >= 1.0) phase -= 1.0;
+        return (float) (4.0 * std::abs (u - 0.5) - 1.0);
+    }
+
+    // User wavetable on the same phase; the increment picks the mip level
+    float processWavetable (const Wavetable& t, float position) {
+        const float s = t.read (phase, incr, position);
+        phase += incr; if (phase >= 1.0) phase -= 1.0;
+        return s;
+    }
+
+private:
+    const DspTables* tables = nullptr; // also the sample rate: 24 bytes per oscillator
+    double phase = 0.0, incr = 0.0;
+};
@@ -0,0 +1,40 @@
+/*
+    File: TptSvf.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Stereo topology-preserving-transform state variable filter (same
+        structure as juce::dsp::StateVariableTPTFilter) that takes its prewarped
+        gain from the shared table instead of calling tan() on every change.
+*/
+
+#pragma once
+#include "JuceIncludes.h"
+
+class TptSvf {
+public:
+    enum Type { lowpass = 0, bandpass = 1, highpass = 2 };
+
+    void reset() { s1[0] = s1[1] = s2[0] = s2[1] = 0.0f; }
+    void setType (int t) { type = t; }
+
+    // g = tan (pi fc / fs), typically from DspTables::prewarpLog2
+    void setCoefficients (float prewarpedG, float resonance) {
+        g = prewarpedG; R2 = 1.0f / resonance;
+        h = 1.0f / (1.0f + R2 * g + g * g);
+    }
+
+    float processSample (int ch, float x) {
+        auto& ls1 = s1[ch]; auto& ls2 = s2[ch];
+        const float yHP = h * (x - ls1 * (g + R2) - ls2);
+        const float yBP = yHP * g + ls1; ls1 = yHP * g + yBP;
+        const float yLP = yBP * g + ls2; ls2 = yBP * g + yLP;
+        return type == lowpass ? yLP : type == bandpass ? yBP : yHP;
+    }
+
+private:
+    float g = 0.0f, R2 = 1.0f, h = 1.0f;
+    float s1[2] {}, s2[2] {};
+    int type = lowpass;
+};
@@ -0,0 +1,162 @@
+/*
+    File: Tuning.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Scala .scl / .kbm parsing, compilation into note tables, and the
+        tuning slot handover.
+*/
+
+#include "Tuning.h"
+#include <cmath>
+
+using namespace juce;
+
+namespace {
+// Lines that are not Scala comments ('!'), trailing whitespace removed
+StringArray dataLines (const String& text) {
+    StringArray lines;
+    for (const auto& l : StringArray::fromLines (text))
+        if (! l.startsWithChar ('!')) lines.add (l.trimEnd());
+    return lines;
+}
+
+int floorDiv (int a, int b) { return a >= 0 ? a / b : -((-a + b - 1) / b); }
+}
+
+const TuningTable& TuningTable::equal() {
+    static const TuningTable table = [] {
+        TuningTable t;
+        for (int n = 0; n < 128; ++n) {
+            t.hz[n] = (float) MidiMessage::getMidiNoteInHertz (n);
+            t.log2Hz[n] = (float) ((n - 69) / 12.0 + std::log2 (440.0));
+        }
+        t.name = "12-TET";
+        return t;
+    }();
+    return table;
+}
+
+bool Scala::parseScale (const String& text, Scale& scale, String& error) {
+    const auto lines = dataLines (text);
+    if (lines.size() < 2) { error = "missing description or note count"; return false; }
+
+    scale.description = lines[0].trim();
+    const int count = lines[1].trim().getIntValue();
+    if (count < 1 || count > 1024) { error = "note count must be 1..1024"; return false; }
+    if (lines.size() < 2 + count) { error = "expected " + String (count) + " pitches, found " + String (lines.size() - 2); return false; }
+
+    // A pitch with a '.' is in cents, otherwise a ratio (n/d or n); text after it is ignored
+    scale.cents.clear();
+    for (int i = 0; i < count; ++i) {
+        const auto token = lines[2 + i].trim().upToFirstOccurrenceOf (" ", false, false).upToFirstOccurrenceOf ("\t", false, false);
+        double cents;
+        if (token.containsChar ('.')) cents = token.getDoubleValue();
+        else {
+            const double num = token.upToFirstOccurrenceOf ("/", false, false).getDoubleValue();
+            const double den = token.containsChar ('/') ? token.fromFirstOccurrenceOf ("/", false, false).getDoubleValue() : 1.0;
+            if (num <= 0.0 || den <= 0.0) { error = "bad ratio '" + token + "' on pitch " + String (i + 1); return false; }
+            cents = 1200.0 * std::log2 (num / den);
+        }
+        scale.cents.push_back (cents);
+    }
+    if (scale.cents.back() <= 0.0) { error = "the last pitch (the period) must be above 1/1"; return false; }
+    return true;
+}
+
+bool Scala::parseMapping (const String& text, Mapping& m, String& error) {
+    const auto lines = dataLines (text);
+    if (lines.size() < 7) { error = "expected 7 header lines, found " + String (lines.size()); return false; }
+
+    const auto field = [&] (int i) { return lines[i].trim().upToFirstOccurrenceOf (" ", false, false); };
+    m.size = field (0).getIntValue();
+    m.first = field (1).getIntValue(); m.last = field (2).getIntValue();
+    m.middle = field (3).getIntValue(); m.reference = field (4).getIntValue();
+    m.frequency = field (5).getDoubleValue();
+    m.octaveDegree = field (6).getIntValue();
+    if (m.size < 0 || m.size > 1024) { error = "map size must be 0..1024"; return false; }
+    if (! isPositiveAndBelow (m.reference, 128) || m.frequency <= 0.0) { error = "bad reference note or frequency"; return false; }
+
+    // Missing trailing entries are unmapped
+    m.keys.assign ((size_t) m.size, -1);
+    for (int i = 0; i < m.size && 7 + i < lines.size(); ++i) {
+        const auto entry = field (7 + i);
+        m.keys[(size_t) i] = entry.startsWithIgnoreCase ("x") || entry.isEmpty() ? -1 : entry.getIntValue();
+    }
+    return true;
+}
+
+std::shared_ptr<const TuningTable> Scala::compile (const Scale& scale, const Mapping& m) {
+    const int n = (int) scale.cents.size();
+    const double period = scale.cents.back();
+    const int octave = m.octaveDegree > 0 ? m.octaveDegree : n;
+
+    const auto centsOf = [&] (int degree) {
+        const int q = floorDiv (degree, n), r = degree - q * n;
+        return q * period + (r == 0 ? 0.0 : scale.cents[(size_t) (r - 1)]);
+    };
+    // Scale degree of a key, or false when it is unmapped
+    const auto degreeOf = [&] (int key, int& degree) {
+        const int offset = key - m.middle;
+        if (m.size == 0) { degree = offset; return true; }
+        const int q = floorDiv (offset, m.size), entry = m.keys[(size_t) (offset - q * m.size)];
+        degree = q * octave + jmax (0, entry);
+        return entry >= 0;
+    };
+
+    int refDegree = 0;
+    degreeOf (m.reference, refDegree);
+    const double refCents = centsOf (refDegree);
+
+    auto t = std::make_shared<TuningTable> (TuningTable::equal());
+    t->name = scale.description.isNotEmpty() ? scale.description : String (n) + "-note scale";
+    for (int key = 0; key < 128; ++key) {
+        int degree = 0;
+        if (key < m.first || key > m.last || ! degreeOf (key, degree)) continue;
+        const double hz = jlimit (1.0, 20000.0, m.frequency * std::exp2 ((centsOf (degree) - refCents) / 1200.0));
+        t->hz[key] = (float) hz;
+        t->log2Hz[key] = (float) std::log2 (hz);
+    }
+    return t;
+}
+
+std::shared_ptr<const TuningTable> Scala::load (const File& scl, const File& kbm, String& error) {
+    Scale scale;
+    if (! scl.existsAsFile()) { error = "file not found: " + scl.getFullPathName(); return {}; }
+    if (! parseScale (scl.loadFileAsString(), scale, error)) { error = scl.getFileName() + ": " + error; return {}; }
+
+    Mapping mapping;
+    if (kbm != File()) {
+        if (! kbm.existsAsFile()) { error = "file not found: " + kbm.getFullPathName(); return {}; }
+        if (! parseMapping (kbm.loadFileAsString(), mapping, error)) { error = kbm.getFileName() + ": " + error; return {}; }
+    }
+    return compile (scale, mapping);
+}
+
+void TuningSlot::set (std::shared_ptr<const TuningTable> t) {
+    collect();
+    published.store (t.get());
+    if (owned != nullptr) retired.push_back ({ std::move (owned), blocksDone.load() });
+    owned = std::move (t);
+}
+
+void TuningSlot::collect() {
+    // Same rule as WavetableSlots: idle, or a block has ended since the swap
+    const bool idle = ! inBlock.load();
+    const auto done = blocksDone.load();
+    retired.erase (std::remove_if (retired.begin(), retired.end(),
+                                   [=] (const Retired& r) { return idle || done > r.blocksAtSwap; }),
+                   retired.end());
+}
+
+void TuningSlot::beginBlock() noexcept {
+    inBlock.store (true);
+    const auto* t = published.load();
+    table = t != nullptr ? t : &TuningTable::equal();
+}
+
+void TuningSlot::endBlock() noexcept {
+    inBlock.store (false);
+    blocksDone.fetch_add (1);
+}
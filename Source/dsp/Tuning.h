@@ -0,0 +1,77 @@
+/*
+    File: Tuning.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Microtuning. A Scala scale (.scl) and optional keyboard mapping (.kbm)
+        are compiled on the message thread into per-note frequency and log2
+        frequency tables. TuningSlot hands a table to the audio thread with
+        one atomic pointer swap, like WavetableSlots. Voices read the table at
+        note-on only, so a retune changes the next notes and never moves a
+        sounding one.
+*/
+
+#pragma once
+#include "JuceIncludes.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+struct TuningTable {
+    float hz[128] {};     // per MIDI note
+    float log2Hz[128] {}; // log2 (hz): voices add bend in octaves to this
+    juce::String name;
+
+    // 12-TET, A4 = 440 Hz: used when no tuning is loaded
+    static const TuningTable& equal();
+};
+
+namespace Scala {
+    // Degrees 1..n in cents; the last one is the period (usually 1200)
+    struct Scale { juce::String description; std::vector<double> cents; };
+
+    // .kbm fields. size 0 = linear mapping; keys[i] = scale degree of key middle + i, -1 = unmapped
+    struct Mapping {
+        int size = 0, first = 0, last = 127, middle = 60, reference = 69, octaveDegree = 0;
+        double frequency = 440.0;
+        std::vector<int> keys;
+    };
+
+    bool parseScale (const juce::String& text, Scale& scale, juce::String& error);
+    bool parseMapping (const juce::String& text, Mapping& mapping, juce::String& error);
+
+    // Keys outside [first, last] and unmapped keys keep their 12-TET pitch
+    std::shared_ptr<const TuningTable> compile (const Scale& scale, const Mapping& mapping);
+
+    // Message thread. kbm may be File() (default mapping: degree 0 on middle C, A4 = 440 Hz).
+    // nullptr with 'error' set on failure.
+    std::shared_ptr<const TuningTable> load (const juce::File& scl, const juce::File& kbm, juce::String& error);
+}
+
+// Message thread -> audio thread handover. set() publishes a table with one atomic store;
+// the table it replaces is kept until the audio thread is past every block that could
+// have picked it up.
+class TuningSlot {
+public:
+    // Message thread; nullptr = 12-TET
+    void set (std::shared_ptr<const TuningTable> table);
+    const std::shared_ptr<const TuningTable>& get() const { return owned; }
+    void collect();
+
+    // Audio thread, around each block: voices read current() in between
+    void beginBlock() noexcept;
+    void endBlock() noexcept;
+    const TuningTable& current() const noexcept { return *table; }
+
+private:
+    std::shared_ptr<const TuningTable> owned;
+    std::atomic<const TuningTable*> published { nullptr };
+    std::atomic<bool> inBlock { false };
+    std::atomic<juce::uint64> blocksDone { 0 };
+
+    struct Retired { std::shared_ptr<const TuningTable> table; juce::uint64 blocksAtSwap; };
+    std::vector<Retired> retired;
+
+    const TuningTable* table = &TuningTable::equal(); // audio thread copy for the current block
+};
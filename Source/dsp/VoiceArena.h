@@ -0,0 +1,42 @@
+/*
+    File: VoiceArena.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Fixed pool of SynthVoice objects in one contiguous, cache-line-aligned
+        allocation (instead of one heap block per voice). Voices are built in
+        place once and never move, so each voice's hot state starts on its own
+        cache line and walking the voices in order walks memory in order.
+*/
+
+#pragma once
+#include "SynthVoice.h"
+#include <new>
+
+class VoiceArena {
+public:
+    VoiceArena (int numVoices, const params::Block& paramBlock) : count (juce::jmax (0, numVoices)) {
+        storage = static_cast<SynthVoice*> (::operator new (sizeof (SynthVoice) * (size_t) juce::jmax (1, count),
+                                                            std::align_val_t { alignof (SynthVoice) }));
+        for (int i = 0; i < count; ++i) new (storage + i) SynthVoice (paramBlock);
+    }
+
+    ~VoiceArena() {
+        for (int i = count; --i >= 0;) storage[i].~SynthVoice();
+        ::operator delete (storage, std::align_val_t { alignof (SynthVoice) });
+    }
+
+    SynthVoice& operator[] (int i) noexcept { jassert (juce::isPositiveAndBelow (i, count)); return storage[i]; }
+    const SynthVoice& operator[] (int i) const noexcept { jassert (juce::isPositiveAndBelow (i, count)); return storage[i]; }
+    int size() const noexcept { return count; }
+
+    SynthVoice* begin() noexcept { return storage; }
+    SynthVoice* end() noexcept { return storage + count; }
+
+private:
+    const int count;
+    SynthVoice* storage = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (VoiceArena)
+};
@@ -0,0 +1,197 @@
+/*
+    File: VoiceManager.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Voice allocation (free voice, then oldest released, then oldest held),
+        sustain pedal, and per-note routing of bend / pressure / timbre.
+*/
+
+#include "VoiceManager.h"
+#include "NoteCache.h"
+#include "diag/TraceRecorder.h"
+
+using namespace juce;
+
+VoiceManager::VoiceManager (int numVoices, const params::Block& paramBlock) : block (paramBlock), voices (numVoices, paramBlock), channels (paramBlock) {
+    slots.resize ((size_t) numVoices);
+}
+
+void VoiceManager::prepare (double sampleRate, int maxChunk, int numChannels, const DspTables& tables) {
+    for (auto& v : voices) v.prepare (sampleRate, maxChunk, numChannels, tables);
+}
+
+void VoiceManager::renderNextBlock (AudioBuffer<float>& output, int outStart, const MidiBuffer& midi, int start, int n) {
+    for (auto it = midi.findNextSamplePosition (start); it != midi.cend(); ++it) {
+        const auto meta = *it;
+        if (meta.samplePosition >= start + n) break;
+        handleMidiEvent (meta.getMessage(), meta.samplePosition - start);
+    }
+
+    for (int i = 0; i < voices.size(); ++i) {
+        if (! slots[(size_t) i].awake) continue; // idle voice: its memory is not touched
+        auto& v = voices[i];
+        v.renderNextBlock (output, outStart, n);
+        if (! v.isSounding()) slots[(size_t) i] = {};
+    }
+}
+
+void VoiceManager::handleMidiEvent (const MidiMessage& m, int offset) {
+    const int ch = m.getChannel();
+    if (ch < 1 || ch > 16) return; // sysex / meta
+    if (onlyChannel != 0 && ch != onlyChannel) return;
+    MS_TRACE_INSTANT ("midi", "midi", m.getRawData()[0]);
+
+    channels.update (m);
+
+    if (m.isNoteOn())                 noteOn (ch, m.getNoteNumber(), m.getFloatVelocity(), offset);
+    else if (m.isNoteOff())           noteOff (ch, m.getNoteNumber(), offset);
+    else if (m.isAllNotesOff() || m.isAllSoundOff()) {
+        for (int i = 0; i < voices.size(); ++i) {
+            auto& s = slots[(size_t) i];
+            if (s.note >= 0 && channels.controls (ch, s.channel)) {
+                queue (i, m.isAllSoundOff() ? SynthVoice::Event::Kill : SynthVoice::Event::NoteOff, offset, s.note, 0.0f);
+                s.keyDown = s.sustained = false;
+            }
+        }
+    }
+    else if (m.isPitchWheel()) {
+        const bool master = channels.isMaster (ch);
+        for (int i = 0; i < voices.size(); ++i) {
+            const auto& s = slots[(size_t) i];
+            if (s.note < 0) continue;
+            if (master && channels.zoneOf (s.channel) == channels.zoneOf (ch))
+                queue (i, SynthVoice::Event::MasterBend, offset, s.note, channels.masterBendSemitones (s.channel));
+            else if (! master && s.channel == ch)
+                queue (i, SynthVoice::Event::NoteBend, offset, s.note, channels.noteBendSemitones (ch));
+        }
+    }
+    else if (m.isChannelPressure()) {
+        for (int i = 0; i < voices.size(); ++i)
+            if (slots[(size_t) i].note >= 0 && slots[(size_t) i].channel == ch)
+                queue (i, SynthVoice::Event::Pressure, offset, slots[(size_t) i].note, channels.pressure (ch));
+    }
+    else if (m.isAftertouch()) {
+        for (int i = 0; i < voices.size(); ++i)
+            if (slots[(size_t) i].note == m.getNoteNumber() && slots[(size_t) i].channel == ch)
+                queue (i, SynthVoice::Event::Pressure, offset, slots[(size_t) i].note, m.getAfterTouchValue() / 127.0f);
+    }
+    else if (m.isSustainPedalOff()) sustainPedal (ch, false, offset);
+    else if (m.isControllerOfType (74) && channels.mpeActive()) {
+        for (int i = 0; i < voices.size(); ++i)
+            if (slots[(size_t) i].note >= 0 && slots[(size_t) i].channel == ch)
+                queue (i, SynthVoice::Event::Timbre, offset, slots[(size_t) i].note, channels.timbre (ch));
+    }
+}
+
+void VoiceManager::noteOn (int channel, int note, float velocity, int offset) {
+    // Same note held on the same channel: release it first (as juce::Synthesiser does)
+    for (int i = 0; i < voices.size(); ++i) {
+        auto& s = slots[(size_t) i];
+        if (s.note == note && s.channel == channel && (s.keyDown || s.sustained)) {
+            queue (i, SynthVoice::Event::NoteOff, offset, note, 0.0f);
+            s.keyDown = s.sustained = false;
+        }
+    }
+
+    int v = findFreeVoice();
+    if (v < 0) v = findVoiceToSteal();
+    if (v < 0) return;
+
+    slots[(size_t) v] = { note, channel, true, false, true, ++noteCounter };
+
+    // Current channel expression goes first so the voice starts on it without gliding
+    queue (v, SynthVoice::Event::NoteBend,   offset, note, channels.noteBendSemitones (channel));
+    queue (v, SynthVoice::Event::MasterBend, offset, note, channels.masterBendSemitones (channel));
+    queue (v, SynthVoice::Event::Pressure,   offset, note, channels.pressure (channel));
+    queue (v, SynthVoice::Event::Timbre,     offset, note, channels.timbre (channel));
+
+    // Freeze: a stored render stands in for the voice DSP. Only from neutral expression,
+    // since a frozen note does not follow bend / pressure / timbre.
+    const bool neutral = channels.noteBendSemitones (channel) == 0.0f && channels.masterBendSemitones (channel) == 0.0f
+                      && channels.pressure (channel) == 0.0f && channels.timbre (channel) == 0.0f;
+    if (cache != nullptr && neutral && ! voices[v].hasPendingFrozen() && NoteCache::isFreezable (block)) {
+        const auto& t = tuning != nullptr ? tuning->current() : TuningTable::equal();
+        if (auto* frozen = cache->acquire (NoteCache::patchKey (block), note, t, block)) {
+            voices[v].setPendingFrozen (frozen);
+            queue (v, SynthVoice::Event::FrozenNoteOn, offset, note, velocity);
+            return;
+        }
+    }
+    queue (v, SynthVoice::Event::NoteOn, offset, note, velocity);
+}
+
+void VoiceManager::noteOff (int channel, int note, int offset) {
+    for (int i = 0; i < voices.size(); ++i) {
+        auto& s = slots[(size_t) i];
+        if (s.note != note || s.channel != channel || ! s.keyDown) continue;
+
+        s.keyDown = false;
+        if (channels.sustainHeld (channel)) s.sustained = true;
+        else queue (i, SynthVoice::Event::NoteOff, offset, note, 0.0f);
+    }
+}
+
+void VoiceManager::sustainPedal (int channel, bool down, int offset) {
+    if (down) return;
+
+    for (int i = 0; i < voices.size(); ++i) {
+        auto& s = slots[(size_t) i];
+        if (s.sustained && channels.controls (channel, s.channel) && ! channels.sustainHeld (s.channel)) {
+            s.sustained = false;
+            queue (i, SynthVoice::Event::NoteOff, offset, s.note, 0.0f);
+        }
+    }
+}
+
+void VoiceManager::allNotesOff (int channel, bool allowTailOff) {
+    for (int i = 0; i < voices.size(); ++i) {
+        auto& s = slots[(size_t) i];
+        if (s.note >= 0 && (channel == 0 || channels.controls (channel, s.channel))) {
+            queue (i, allowTailOff ? SynthVoice::Event::NoteOff : SynthVoice::Event::Kill, 0, s.note, 0.0f);
+            s.keyDown = s.sustained = false;
+        }
+    }
+    channels.clearSustain (channel);
+}
+
+void VoiceManager::limitPolyphony (int maxNotes) {
+    for (;;) {
+        // By note-on order, not level: a note still in its attack is quiet but new
+        int held = 0, oldest = -1;
+        for (int i = 0; i < voices.size(); ++i) {
+            const auto& s = slots[(size_t) i];
+            if (s.note < 0 || ! (s.keyDown || s.sustained)) continue;
+            ++held;
+            if (oldest < 0 || s.age < slots[(size_t) oldest].age) oldest = i;
+        }
+        if (held <= maxNotes) return;
+
+        auto& s = slots[(size_t) oldest];
+        queue (oldest, SynthVoice::Event::NoteOff, 0, s.note, 0.0f);
+        s.keyDown = s.sustained = false;
+    }
+}
+
+int VoiceManager::findFreeVoice() const {
+    for (int i = 0; i < voices.size(); ++i)
+        if (slots[(size_t) i].note < 0 && ! slots[(size_t) i].awake) return i;
+    return -1;
+}
+
+int VoiceManager::findVoiceToSteal() const {
+    int oldestReleased = -1, oldest = -1;
+    for (int i = 0; i < voices.size(); ++i) {
+        const auto& s = slots[(size_t) i];
+        if (! s.keyDown && ! s.sustained && (oldestReleased < 0 || s.age < slots[(size_t) oldestReleased].age)) oldestReleased = i;
+        if (oldest < 0 || s.age < slots[(size_t) oldest].age) oldest = i;
+    }
+    return oldestReleased >= 0 ? oldestReleased : oldest;
+}
+
+void VoiceManager::queue (int voice, SynthVoice::Event::Type type, int offset, int note, float value) {
+    if (! voices[voice].queueEvent ({ offset, type, note, value }))
+        eventsDropped.fetch_add (1, std::memory_order_relaxed);
+    slots[(size_t) voice].awake = true;
+}
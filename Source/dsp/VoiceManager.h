@@ -0,0 +1,92 @@
+/*
+    File: VoiceManager.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Polyphonic voice allocator replacing juce::Synthesiser. MIDI events are
+        turned into timestamped voice events and every voice renders each chunk
+        in one pass, instead of the block being split at every MIDI event.
+        With mpeEnabled set, member-channel bend, pressure and CC74 timbre are
+        routed per note and master-channel bend applies to its whole zone.
+*/
+
+#pragma once
+#include "VoiceArena.h"
+#include "MidiChannelState.h"
+#include <atomic>
+
+class NoteCache;
+
+class VoiceManager {
+public:
+    VoiceManager (int numVoices, const params::Block& paramBlock);
+
+    void prepare (double sampleRate, int maxChunk, int numChannels, const DspTables& tables);
+
+    // Dispatches the MIDI in [start, start + n) at its sample offsets, then renders
+    // each voice once over that span (n <= maxChunk).
+    void renderNextBlock (juce::AudioBuffer<float>& output, const juce::MidiBuffer& midi, int start, int n)
+        { renderNextBlock (output, start, midi, start, n); }
+    // Same, into 'output' from outStart (a part's own bus); MIDI positions stay relative to 'start'
+    void renderNextBlock (juce::AudioBuffer<float>& output, int outStart, const juce::MidiBuffer& midi, int start, int n);
+
+    // Multi-timbral parts: only this MIDI channel reaches the voices (0 = all channels)
+    void setChannel (int channel) { onlyChannel = channel; }
+
+    // channel 0 = all channels
+    void allNotesOff (int channel, bool allowTailOff);
+
+    // Eco governor hooks (audio thread, before renderNextBlock)
+    void setQuality (const SynthVoice::Quality& q) { for (auto& v : voices) v.setQuality (q); }
+    // Releases the oldest held / sustained notes until at most maxNotes remain
+    void limitPolyphony (int maxNotes);
+
+    // MPE zone layout, see MidiChannelState
+    void setMpeZones (int lowerMemberChannels, int upperMemberChannels) { channels.setMpeZones (lowerMemberChannels, upperMemberChannels); }
+
+    // Reproducible noise for offline renders: voice i is seeded with seed + i
+    void setNoiseSeed (juce::int64 seed) { for (int i = 0; i < voices.size(); ++i) voices[i].setNoiseSeed (seed + i); }
+
+    // User wavetables the voices read each block (owned by the caller, see WavetableSlots)
+    void setUserTables (const UserTables* t) { for (auto& v : voices) v.setUserTables (t); }
+
+    // Tuning the voices read at note-on (owned by the caller, see TuningSlot)
+    void setTuning (const TuningSlot* t) { tuning = t; for (auto& v : voices) v.setTuning (t); }
+
+    // Freeze: note-ons of a freezable patch play the cache's stored renders (null = never)
+    void setNoteCache (NoteCache* c) { cache = c; }
+
+    int getNumVoices() const { return voices.size(); }
+    // Voice events lost to a full queue (see SynthVoice::queueEvent); any thread
+    juce::uint64 getEventsDropped() const { return eventsDropped.load (std::memory_order_relaxed); }
+
+private:
+    // Allocation state as of the last queued event (the DSP state catches up on render).
+    // Scans over all voices read only these packed slots, never the voices themselves.
+    struct Slot {
+        int note = -1, channel = 0;
+        bool keyDown = false, sustained = false;
+        bool awake = false;   // mirrors SynthVoice::isSounding(): events queued or still sounding
+        juce::uint32 age = 0; // note-on order, for stealing
+    };
+
+    void handleMidiEvent (const juce::MidiMessage& m, int offset);
+    void noteOn (int channel, int note, float velocity, int offset);
+    void noteOff (int channel, int note, int offset);
+    void sustainPedal (int channel, bool down, int offset);
+
+    int findFreeVoice() const;
+    int findVoiceToSteal() const;
+    void queue (int voice, SynthVoice::Event::Type type, int offset, int note, float value);
+
+    const params::Block& block;
+    VoiceArena voices;
+    std::vector<Slot> slots;
+    MidiChannelState channels; // replayed ahead of each note-on
+    int onlyChannel = 0;
+    NoteCache* cache = nullptr;
+    const TuningSlot* tuning = nullptr;
+    juce::uint32 noteCounter = 0;
+    std::atomic<juce::uint64> eventsDropped { 0 };
+};
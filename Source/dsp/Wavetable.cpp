@@ -0,0 +1,287 @@
+/*
+    File: Wavetable.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        WAV import, mip-level construction (FFT band limiting), the cache file
+        format and its process-wide mapping registry, and the slot handover.
+*/
+
+#include "Wavetable.h"
+#include <map>
+
+using namespace juce;
+
+namespace {
+constexpr uint32 cacheMagic = 0x54574d53; // "MSWT"
+constexpr uint32 cacheVersion = 1;
+
+// Cache file: this header, then per level, per frame, levelSize + 1 floats (native endian)
+struct CacheHeader { uint32 magic, version, frameSize, numLevels, numFrames, reserved[3]; };
+static_assert (sizeof (CacheHeader) == 32, "keeps the float data 16-byte aligned in the mapping");
+
+size_t levelFloats (int level, int numFrames) { return (size_t) numFrames * (size_t) (Wavetable::levelSize (level) + 1); }
+
+size_t totalFloats (int numFrames) {
+    size_t n = 0;
+    for (int l = 0; l < Wavetable::numLevels; ++l) n += levelFloats (l, numFrames);
+    return n;
+}
+
+// Source path, size and date in the name: an edited WAV gets a fresh cache entry
+File cacheFileFor (const File& wav) {
+    const auto key = wav.getFullPathName() + "|" + String (wav.getSize()) + "|"
+                   + String (wav.getLastModificationTime().toMilliseconds()) + "|" + String (cacheVersion);
+    return WavetableLibrary::getCacheDirectory()
+             .getChildFile (wav.getFileNameWithoutExtension() + "-" + String::toHexString (key.hashCode64()) + ".mswt");
+}
+
+// Mono frames of Wavetable::frameSize. A length that is a multiple of the frame size, or
+// longer than two frames, is cut into frames; anything else is one cycle, stretched to a frame.
+bool readFrames (const File& wav, std::vector<float>& frames, int& numFrames, String& error) {
+    AudioFormatManager formats;
+    formats.registerBasicFormats();
+    std::unique_ptr<AudioFormatReader> reader (formats.createReaderFor (wav));
+    if (reader == nullptr) { error = "not a readable audio file"; return false; }
+
+    const int length = (int) jmin (reader->lengthInSamples, (int64) Wavetable::frameSize * Wavetable::maxFrames);
+    if (length < 2) { error = "the file holds no samples"; return false; }
+
+    AudioBuffer<float> buffer ((int) reader->numChannels, length);
+    reader->read (&buffer, 0, length, 0, true, true);
+    std::vector<float> mono ((size_t) length, 0.0f);
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        FloatVectorOperations::addWithMultiply (mono.data(), buffer.getReadPointer (ch), 1.0f / (float) buffer.getNumChannels(), length);
+
+    constexpr int n = Wavetable::frameSize;
+    if (length % n == 0 || length > 2 * n) {
+        numFrames = length / n;
+        frames.assign (mono.begin(), mono.begin() + numFrames * n);
+    } else {
+        numFrames = 1;
+        frames.resize ((size_t) n);
+        for (int i = 0; i < n; ++i) {
+            const double x = (double) i * length / n;
+            const int j = (int) x; const float frac = (float) (x - j);
+            frames[(size_t) i] = mono[(size_t) j] + frac * (mono[(size_t) ((j + 1) % length)] - mono[(size_t) j]);
+        }
+    }
+    return true;
+}
+}
+
+// Builds and maps cache files; the only code allowed to fill a Wavetable
+struct WavetableLoader {
+    static bool build (const File& wav, const File& cache, String& error) {
+        std::vector<float> frames; int numFrames = 0;
+        if (! readFrames (wav, frames, numFrames, error)) return false;
+
+        // One FFT per frame; each level zeroes DC and the harmonics it cannot hold, then
+        // keeps every (frameSize / levelSize)-th sample of the inverse
+        constexpr int n = Wavetable::frameSize;
+        dsp::FFT fft (11);
+        jassert (fft.getSize() == n);
+        std::vector<float> spectrum ((size_t) (2 * n)), work ((size_t) (2 * n));
+        std::vector<float> out (totalFloats (numFrames));
+
+        for (int f = 0; f < numFrames; ++f) {
+            std::fill (spectrum.begin(), spectrum.end(), 0.0f);
+            std::copy_n (frames.begin() + f * n, n, spectrum.begin());
+            fft.performRealOnlyForwardTransform (spectrum.data(), true);
+
+            size_t offset = 0;
+            for (int l = 0; l < Wavetable::numLevels; ++l) {
+                const int size = Wavetable::levelSize (l);
+                const int highest = jmin ((n / 2) >> l, size / 2 - 1);
+                work = spectrum;
+                work[0] = work[1] = 0.0f;
+                std::fill (work.begin() + 2 * (highest + 1), work.begin() + n + 2, 0.0f);
+                fft.performRealOnlyInverseTransform (work.data());
+
+                float* dst = out.data() + offset + (size_t) f * (size_t) (size + 1);
+                for (int i = 0; i < size; ++i) dst[i] = work[(size_t) (i * (n / size))];
+                dst[size] = dst[0];
+                offset += levelFloats (l, numFrames);
+            }
+        }
+
+        // Peak of the full-band level to 1, same gain everywhere so levels stay matched
+        const auto range = FloatVectorOperations::findMinAndMax (out.data(), (int) levelFloats (0, numFrames));
+        const float peak = jmax (std::abs (range.getStart()), std::abs (range.getEnd()));
+        if (peak > 0.0f) FloatVectorOperations::multiply (out.data(), 1.0f / peak, (int) out.size());
+
+        if (! cache.getParentDirectory().createDirectory()) { error = "cannot create " + cache.getParentDirectory().getFullPathName(); return false; }
+        TemporaryFile temp (cache);
+        {
+            FileOutputStream os (temp.getFile());
+            const CacheHeader h { cacheMagic, cacheVersion, (uint32) n, (uint32) Wavetable::numLevels, (uint32) numFrames, {} };
+            if (! os.openedOk() || ! os.write (&h, sizeof (h)) || ! os.write (out.data(), out.size() * sizeof (float))) {
+                error = "cannot write " + cache.getFullPathName(); return false;
+            }
+        }
+        if (! temp.overwriteTargetFileWithTemporary()) { error = "cannot write " + cache.getFullPathName(); return false; }
+        return true;
+    }
+
+    // nullptr when the cache file is missing, truncated or from another format version
+    static std::shared_ptr<const Wavetable> map (const File& cache, const File& wav) {
+        auto mapping = std::make_unique<MemoryMappedFile> (cache, MemoryMappedFile::readOnly);
+        if (mapping->getData() == nullptr || mapping->getSize() < sizeof (CacheHeader)) return {};
+
+        CacheHeader h;
+        std::memcpy (&h, mapping->getData(), sizeof (h));
+        const bool valid = h.magic == cacheMagic && h.version == cacheVersion
+                        && h.frameSize == (uint32) Wavetable::frameSize && h.numLevels == (uint32) Wavetable::numLevels
+                        && h.numFrames >= 1 && h.numFrames <= (uint32) Wavetable::maxFrames
+                        && mapping->getSize() == sizeof (h) + totalFloats ((int) h.numFrames) * sizeof (float);
+        if (! valid) return {};
+
+        std::shared_ptr<Wavetable> table (new Wavetable());
+        table->numFrames = (int) h.numFrames;
+        table->data = reinterpret_cast<const float*> (static_cast<const char*> (mapping->getData()) + sizeof (h));
+        size_t offset = 0;
+        for (int l = 0; l < Wavetable::numLevels; ++l) { table->levelOffset[l] = offset; offset += levelFloats (l, table->numFrames); }
+        table->map = std::move (mapping);
+        table->source = wav;
+        return table;
+    }
+};
+
+File WavetableLibrary::getCacheDirectory() {
+    return File::getSpecialLocation (File::userApplicationDataDirectory)
+             .getChildFile ("YourName").getChildFile ("MiniSynth").getChildFile ("WavetableCache");
+}
+
+namespace {
+// Process-wide mappings, keyed by cache file. The lock only covers the map: builds run
+// outside it, and two threads building the same file both write it atomically.
+struct Registry {
+    CriticalSection lock;
+    std::map<String, std::weak_ptr<const Wavetable>> tables;
+
+    std::shared_ptr<const Wavetable> get (const File& cache) {
+        const ScopedLock sl (lock);
+        return tables[cache.getFullPathName()].lock();
+    }
+
+    // The first mapping registered for a file wins
+    std::shared_ptr<const Wavetable> add (const File& cache, std::shared_ptr<const Wavetable> table) {
+        const ScopedLock sl (lock);
+        auto& slot = tables[cache.getFullPathName()];
+        if (auto existing = slot.lock()) return existing;
+        slot = table;
+        return table;
+    }
+};
+
+Registry& registry() { static Registry r; return r; }
+}
+
+std::shared_ptr<const Wavetable> WavetableLibrary::find (const File& wav) {
+    if (! wav.existsAsFile()) return {};
+    const auto cache = cacheFileFor (wav);
+    if (auto existing = registry().get (cache)) return existing;
+
+    auto table = WavetableLoader::map (cache, wav); // built by an earlier session or another process
+    return table != nullptr ? registry().add (cache, std::move (table)) : nullptr;
+}
+
+std::shared_ptr<const Wavetable> WavetableLibrary::load (const File& wav, String& error) {
+    if (! wav.existsAsFile()) { error = "file not found: " + wav.getFullPathName(); return {}; }
+    if (auto table = find (wav)) return table;
+
+    const auto cache = cacheFileFor (wav);
+    if (! WavetableLoader::build (wav, cache, error)) return {};
+    auto table = WavetableLoader::map (cache, wav);
+    if (table == nullptr) { error = "cannot map " + cache.getFullPathName(); return {}; }
+    return registry().add (cache, std::move (table));
+}
+
+void WavetableSlots::set (int slot, std::shared_ptr<const Wavetable> table) {
+    jassert (isPositiveAndBelow (slot, UserTables::numSlots));
+    collect();
+    published[slot].store (table.get());
+    if (owned[slot] != nullptr) retired.push_back ({ std::move (owned[slot]), blocksDone.load() });
+    owned[slot] = std::move (table);
+}
+
+void WavetableSlots::collect() {
+    // Safe once no block is running, or once a block has ended since the swap: any later
+    // block read the new pointer
+    const bool idle = ! inBlock.load();
+    const auto done = blocksDone.load();
+    retired.erase (std::remove_if (retired.begin(), retired.end(),
+                                   [=] (const Retired& r) { return idle || done > r.blocksAtSwap; }),
+                   retired.end());
+}
+
+void WavetableSlots::beginBlock() noexcept {
+    inBlock.store (true);
+    for (int i = 0; i < UserTables::numSlots; ++i) tables.osc[i] = published[i].load();
+}
+
+void WavetableSlots::endBlock() noexcept {
+    inBlock.store (false);
+    blocksDone.fetch_add (1);
+}
+
+void WavetableImporter::request (int slot, const File& wav) {
+    jassert (isPositiveAndBelow (slot, UserTables::numSlots));
+    cancel (slot);
+    {
+        const ScopedLock sl (lock);
+        jobs[slot].wav = wav;
+    }
+    if (! isThreadRunning()) startThread();
+    notify();
+}
+
+void WavetableImporter::cancel (int slot) {
+    const ScopedLock sl (lock);
+    jobs[slot].wav = File();
+    ++jobs[slot].generation;
+    done.erase (std::remove_if (done.begin(), done.end(), [=] (const Result& r) { return r.slot == slot; }), done.end());
+}
+
+File WavetableImporter::getPending (int slot) const {
+    const ScopedLock sl (lock);
+    return jobs[slot].wav;
+}
+
+void WavetableImporter::waitUntilIdle() const {
+    for (int i = 0; i < UserTables::numSlots; ++i)
+        while (getPending (i) != File()) Thread::sleep (5);
+}
+
+std::vector<WavetableImporter::Result> WavetableImporter::collect() {
+    std::vector<Result> results;
+    const ScopedLock sl (lock);
+    results.swap (done);
+    return results;
+}
+
+void WavetableImporter::run() {
+    while (! threadShouldExit()) {
+        int slot = -1; File wav; uint32 generation = 0;
+        {
+            const ScopedLock sl (lock);
+            for (int i = 0; i < UserTables::numSlots && slot < 0; ++i) {
+                auto& j = jobs[i];
+                if (j.wav == File() || j.running) continue;
+                slot = i; wav = j.wav; generation = j.generation; j.running = true;
+            }
+        }
+        if (slot < 0) { wait (-1); continue; }
+
+        String error;
+        auto table = WavetableLibrary::load (wav, error);
+
+        const ScopedLock sl (lock);
+        auto& j = jobs[slot];
+        j.running = false;
+        if (j.generation != generation) continue; // superseded: the newer job is picked up next
+        done.push_back ({ slot, std::move (table), error });
+        j.wav = File();
+    }
+}
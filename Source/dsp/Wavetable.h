@@ -0,0 +1,141 @@
+/*
+    File: Wavetable.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        User wavetables (the oscillators' Table switches). A WAV file, single cycle or
+        consecutive 2048-sample frames, is preprocessed once into a mip-mapped
+        cache file (one band-limited copy per octave) that is memory-mapped
+        read-only. One mapping per file is shared by every voice of every
+        instance in the process, and the OS shares its pages between processes.
+        WavetableSlots hands tables to the audio thread without allocating or
+        locking there; WavetableImporter builds missing cache files on a
+        background thread.
+*/
+
+#pragma once
+#include "JuceIncludes.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class Wavetable {
+public:
+    static constexpr int frameSize = 2048;  // level 0 samples per frame (Serum convention)
+    static constexpr int numLevels = 11;    // level l keeps harmonics below 1024 >> l
+    static constexpr int minLevelSize = 64;
+    static constexpr int maxFrames = 256;
+
+    // Samples per frame at a level; each frame is stored with a guard sample (= first)
+    static constexpr int levelSize (int level) { return (frameSize >> level) > minLevelSize ? frameSize >> level : minLevelSize; }
+
+    int getNumFrames() const { return numFrames; }
+    const juce::File& getSource() const { return source; }
+
+    const float* frame (int level, int index) const noexcept {
+        return data + levelOffset[level] + (size_t) index * (size_t) (levelSize (level) + 1);
+    }
+
+    // Audio thread. phase01 in [0, 1), incr = frequency / sample rate (picks the mip level),
+    // position in [0, 1] across the frames (crossfaded)
+    float read (double phase01, double incr, float position) const noexcept {
+        int e; const double m = std::frexp (incr * frameSize, &e);
+        const int level = juce::jlimit (0, numLevels - 1, m == 0.5 ? e - 1 : e); // ceil (log2 (incr * frameSize))
+        const int size = levelSize (level);
+
+        const float fp = juce::jlimit (0.0f, 1.0f, position) * (float) (numFrames - 1);
+        const int f0 = (int) fp, f1 = juce::jmin (f0 + 1, numFrames - 1);
+        const float ff = fp - (float) f0;
+
+        const double x = phase01 * size;
+        const int i = (int) x; const float frac = (float) (x - i);
+        const float* a = frame (level, f0) + i;
+        const float* b = frame (level, f1) + i;
+        const float sa = a[0] + frac * (a[1] - a[0]);
+        const float sb = b[0] + frac * (b[1] - b[0]);
+        return sa + ff * (sb - sa);
+    }
+
+private:
+    friend struct WavetableLoader;
+    Wavetable() = default;
+
+    std::unique_ptr<juce::MemoryMappedFile> map;
+    const float* data = nullptr;
+    size_t levelOffset[numLevels] {}; // in floats from 'data'
+    int numFrames = 0;
+    juce::File source;
+};
+
+namespace WavetableLibrary {
+    // Any thread; slow on a cache miss (WAV read, FFTs, cache write). Imports a WAV (single
+    // cycle: up to 4096 samples; otherwise consecutive 2048-sample frames, at most 256),
+    // building its cache file on first use, and returns the process-wide mapping. nullptr
+    // with 'error' set on failure.
+    std::shared_ptr<const Wavetable> load (const juce::File& wavFile, juce::String& error);
+
+    // Any thread, cheap. The process-wide mapping if the cache file exists, else nullptr.
+    std::shared_ptr<const Wavetable> find (const juce::File& wavFile);
+
+    juce::File getCacheDirectory();
+}
+
+// Per-oscillator user tables, as the voices see them for one block
+struct UserTables {
+    static constexpr int numSlots = 3;
+    const Wavetable* osc[numSlots] {};
+};
+
+// Message thread -> audio thread handover. set() publishes a table with one atomic store;
+// the table it replaces stays mapped until the audio thread is past every block that
+// could have picked it up.
+class WavetableSlots {
+public:
+    // Message thread
+    void set (int slot, std::shared_ptr<const Wavetable> table);
+    const std::shared_ptr<const Wavetable>& get (int slot) const { return owned[slot]; }
+    void collect(); // unmaps replaced tables the audio thread is done with
+
+    // Audio thread, around each block: voices read current() in between
+    void beginBlock() noexcept;
+    void endBlock() noexcept;
+    const UserTables& current() const noexcept { return tables; }
+
+private:
+    std::shared_ptr<const Wavetable> owned[UserTables::numSlots];
+    std::atomic<const Wavetable*> published[UserTables::numSlots] {};
+    std::atomic<bool> inBlock { false };
+    std::atomic<juce::uint64> blocksDone { 0 };
+
+    struct Retired { std::shared_ptr<const Wavetable> table; juce::uint64 blocksAtSwap; };
+    std::vector<Retired> retired;
+
+    UserTables tables; // audio thread copy for the current block
+};
+
+// Runs WavetableLibrary::load off the message thread, one job per slot; a newer request
+// or cancel() for a slot supersedes the one in flight. The owner polls collect() on the
+// message thread and installs the finished tables with WavetableSlots::set().
+class WavetableImporter : private juce::Thread {
+public:
+    WavetableImporter() : Thread ("MiniSynth wavetable import") {}
+    ~WavetableImporter() override { stopThread (5000); }
+
+    // Message thread
+    void request (int slot, const juce::File& wav);
+    void cancel (int slot);
+    juce::File getPending (int slot) const; // queued or being imported, else File()
+    void waitUntilIdle() const;             // offline callers that need the tables now
+
+    struct Result { int slot; std::shared_ptr<const Wavetable> table; juce::String error; };
+    std::vector<Result> collect(); // finished since the last call, still wanted
+
+private:
+    void run() override;
+
+    struct Job { juce::File wav; juce::uint32 generation = 0; bool running = false; };
+    juce::CriticalSection lock;
+    Job jobs[UserTables::numSlots];
+    std::vector<Result> done;
+};
@@ -0,0 +1,218 @@
+/*
+    File: PresetIndex.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Word splitting, snapshot building, the background meta reader and
+        query scoring.
+*/
+
+#include "PresetIndex.h"
+#include <algorithm>
+
+using namespace juce;
+
+namespace presets {
+
+namespace {
+enum Field : uint8 { Name, Tag, Category, Author, AnyField };
+
+// Name hits rank above tags, tags above category, category above author
+constexpr int fieldWeight[] = { 4, 3, 2, 1 };
+
+// Lower-case runs of letters and digits
+StringArray splitWords (const String& text) {
+    StringArray words;
+    String word;
+    for (auto p = text.getCharPointer(); ! p.isEmpty(); ++p) {
+        const auto c = *p;
+        if (CharacterFunctions::isLetterOrDigit (c)) word += CharacterFunctions::toLowerCase (c);
+        else if (word.isNotEmpty()) { words.add (word); word.clear(); }
+    }
+    if (word.isNotEmpty()) words.add (word);
+    return words;
+}
+
+// 'needle' letters appear in 'word' in order ("sqr" finds "square")
+bool isSubsequence (const String& needle, const String& word) {
+    auto w = word.getCharPointer();
+    for (auto n = needle.getCharPointer(); ! n.isEmpty(); ++n) {
+        while (! w.isEmpty() && *w != *n) ++w;
+        if (w.isEmpty()) return false;
+        ++w;
+    }
+    return true;
+}
+}
+
+struct PresetIndex::Snapshot {
+    struct Word { String text; int preset; Field field; };
+
+    std::vector<PresetInfo> infos;
+    std::vector<Word> words; // sorted by text, then preset
+
+    static std::shared_ptr<const Snapshot> build (const std::vector<Source>& list) {
+        auto s = std::make_shared<Snapshot>();
+        s->infos.reserve (list.size());
+        for (const auto& src : list) {
+            const int preset = (int) s->infos.size();
+            const auto add = [&] (const String& text, Field f) {
+                for (const auto& w : splitWords (text)) s->words.push_back ({ w, preset, f });
+            };
+            add (src.info.name, Name);
+            add (src.info.category, Category);
+            add (src.info.author, Author);
+            for (const auto& t : src.info.tags) add (t, Tag);
+            s->infos.push_back (src.info);
+        }
+        std::sort (s->words.begin(), s->words.end(), [] (const Word& a, const Word& b) {
+            const int c = a.text.compare (b.text);
+            return c != 0 ? c < 0 : a.preset < b.preset;
+        });
+        return s;
+    }
+};
+
+// Reads the meta of every JSON user preset, then installs the full index
+class PresetIndex::Builder : public Thread {
+public:
+    Builder (PresetIndex& o, std::vector<Source> l) : Thread ("MiniSynth preset index"), owner (o), list (std::move (l)) {}
+
+    void run() override {
+        for (auto& s : list) {
+            if (threadShouldExit()) return;
+            if (s.file.hasFileExtension ("json")) readMeta (s.file, s.info);
+        }
+        owner.install (Snapshot::build (list), true);
+    }
+
+private:
+    PresetIndex& owner;
+    std::vector<Source> list;
+};
+
+PresetIndex::PresetIndex() : snapshot (std::make_shared<Snapshot>()) {}
+
+PresetIndex::~PresetIndex() {
+    if (builder != nullptr) builder->stopThread (2000);
+}
+
+void PresetIndex::rebuild (std::vector<Source> list) {
+    if (builder != nullptr) builder->stopThread (2000);
+    builder.reset();
+
+    // Names now; meta when the builder is done
+    const bool needsMeta = std::any_of (list.begin(), list.end(), [] (const Source& s) { return s.file.hasFileExtension ("json"); });
+    install (Snapshot::build (list), ! needsMeta);
+    if (! needsMeta) return;
+
+    builder = std::make_unique<Builder> (*this, std::move (list));
+    builder->startThread();
+}
+
+void PresetIndex::install (std::shared_ptr<const Snapshot> s, bool done) {
+    {
+        const ScopedLock sl (lock);
+        snapshot.swap (s);
+    }
+    complete.store (done);
+    // The old snapshot is freed here, outside the lock
+}
+
+std::shared_ptr<const PresetIndex::Snapshot> PresetIndex::current() const {
+    const ScopedLock sl (lock);
+    return snapshot;
+}
+
+int PresetIndex::size() const { return (int) current()->infos.size(); }
+
+PresetInfo PresetIndex::getInfo (int preset) const {
+    const auto s = current();
+    return isPositiveAndBelow (preset, (int) s->infos.size()) ? s->infos[(size_t) preset] : PresetInfo();
+}
+
+std::vector<int> PresetIndex::search (const String& query, int maxResults) const {
+    const auto s = current();
+    const int n = (int) s->infos.size();
+    const size_t limit = maxResults > 0 ? (size_t) maxResults : (size_t) n;
+
+    struct Term { String word; Field field; };
+    std::vector<Term> terms;
+    for (const auto& token : StringArray::fromTokens (query, true)) {
+        auto field = AnyField;
+        auto text = token;
+        const auto qualifier = token.upToFirstOccurrenceOf (":", false, false).toLowerCase();
+        if (token.containsChar (':')) {
+            if      (qualifier == "name")                          field = Name;
+            else if (qualifier == "tag")                           field = Tag;
+            else if (qualifier == "cat" || qualifier == "category") field = Category;
+            else if (qualifier == "author")                        field = Author;
+            if (field != AnyField) text = token.fromFirstOccurrenceOf (":", false, false);
+        }
+        for (const auto& w : splitWords (text)) terms.push_back ({ w, field });
+    }
+
+    std::vector<int> out;
+    if (terms.empty()) {
+        for (int i = 0; i < n && out.size() < limit; ++i) out.push_back (i);
+        return out;
+    }
+
+    // total[p] < 0 once a term misses preset p
+    std::vector<int> total ((size_t) n, 0), best ((size_t) n);
+    const auto cmp = [] (const Snapshot::Word& w, const String& t) { return w.text.compare (t) < 0; };
+
+    for (const auto& term : terms) {
+        std::fill (best.begin(), best.end(), 0);
+        bool any = false;
+        const auto score = [&] (const Snapshot::Word& w, int points) {
+            if (term.field != AnyField && w.field != term.field) return;
+            auto& b = best[(size_t) w.preset];
+            b = jmax (b, points * fieldWeight[w.field]);
+            any = true;
+        };
+
+        // Prefix: one contiguous run of the sorted array; whole words count double
+        for (auto it = std::lower_bound (s->words.begin(), s->words.end(), term.word, cmp);
+             it != s->words.end() && it->text.startsWith (term.word); ++it)
+            score (*it, it->text.length() == term.word.length() ? 4 : 2);
+
+        // Fuzzy, only when nothing matched as a prefix; tested once per distinct word
+        if (! any) {
+            const String* last = nullptr; bool hit = false;
+            for (const auto& w : s->words) {
+                if (last == nullptr || w.text != *last) { hit = isSubsequence (term.word, w.text); last = &w.text; }
+                if (hit) score (w, 1);
+            }
+        }
+
+        for (int p = 0; p < n; ++p)
+            total[(size_t) p] = total[(size_t) p] < 0 || best[(size_t) p] == 0 ? -1 : total[(size_t) p] + best[(size_t) p];
+    }
+
+    for (int p = 0; p < n; ++p) if (total[(size_t) p] > 0) out.push_back (p);
+    const auto rank = [&] (int a, int b) { return total[(size_t) a] != total[(size_t) b] ? total[(size_t) a] > total[(size_t) b] : a < b; };
+    if (out.size() > limit) {
+        std::partial_sort (out.begin(), out.begin() + (std::ptrdiff_t) limit, out.end(), rank);
+        out.resize (limit);
+    } else {
+        std::sort (out.begin(), out.end(), rank);
+    }
+    return out;
+}
+
+void PresetIndex::readMeta (const File& file, PresetInfo& info) {
+    const auto meta = JSON::parse (file.loadFileAsString()).getProperty ("meta", var());
+    if (! meta.isObject()) return;
+
+    info.author   = meta.getProperty ("author", var()).toString();
+    info.category = meta.getProperty ("category", var()).toString();
+    const auto tags = meta.getProperty ("tags", var());
+    if (const auto* a = tags.getArray()) for (const auto& t : *a) info.tags.add (t.toString());
+    else if (tags.isString())            info.tags.addTokens (tags.toString(), ",", "\"");
+    info.tags.trim();
+    info.tags.removeEmptyStrings();
+}
+
+} // namespace presets
@@ -0,0 +1,68 @@
+/*
+    File: PresetIndex.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Search index over the preset list: name, tags, author and category
+        (the JSON "meta" block). rebuild() indexes the names straight away;
+        a background thread then reads the meta of user preset files and
+        swaps in the full index, so large libraries never block the editor.
+        Each field is split into lower-case words kept in one sorted array:
+        a prefix query is a binary search, and a word with no prefix match
+        falls back to a fuzzy scan of the distinct words.
+*/
+
+#pragma once
+#include "JuceIncludes.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace presets {
+
+struct PresetInfo {
+    juce::String name, author, category;
+    juce::StringArray tags;
+};
+
+class PresetIndex {
+public:
+    // One list entry. 'file' set = user preset whose meta is read in the background
+    struct Source { PresetInfo info; juce::File file; };
+
+    PresetIndex();
+    ~PresetIndex();
+
+    // Message thread. Replaces the index; any build still running is abandoned.
+    void rebuild (std::vector<Source> list);
+    bool isComplete() const { return complete.load(); } // meta of every file indexed
+
+    // Any thread. Preset indices, best match first; an empty query lists every preset.
+    // Words are ANDed. Each matches a word prefix in any field, or, failing that, a word
+    // containing its letters in order. "tag:", "author:" and "cat:" restrict a word to
+    // one field. maxResults <= 0 = no limit.
+    std::vector<int> search (const juce::String& query, int maxResults = 0) const;
+
+    PresetInfo getInfo (int preset) const;
+    int size() const;
+
+    // Meta of a *.minisynth.json file: { "meta": { "author", "category", "tags": [...] } }
+    static void readMeta (const juce::File& file, PresetInfo& info);
+
+private:
+    struct Snapshot;
+    class Builder;
+
+    std::shared_ptr<const Snapshot> current() const;
+    void install (std::shared_ptr<const Snapshot> s, bool done);
+
+    juce::CriticalSection lock; // guards 'snapshot' only: snapshots are never modified
+    std::shared_ptr<const Snapshot> snapshot;
+    std::atomic<bool> complete { true };
+    std::unique_ptr<Builder> builder;
+
+    JUCE_DECLARE_NON_COPYABLE (PresetIndex)
+};
+
+} // namespace presets
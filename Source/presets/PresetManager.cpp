@@ -4,18 +4,14 @@
     Revision: 1.0.0
     Date: 2025-08-19
     Description:
-        Preset manager implementation. Scans BinaryData and user directory,
-        loads JSON (with optional meta) or XML states, and saves/deletes user presets.
+        Preset manager implementation. Lists the build-time compiled factory
+        tables and the user directory, loads JSON (with optional meta) or XML
+        states, and saves/deletes user presets.
 */
 
 #include "PresetManager.h"
-
-#if __has_include(<BinaryData.h>)
- #include <BinaryData.h>
- #define MS_HAVE_BINARYDATA 1
-#else
- #define MS_HAVE_BINARYDATA 0
-#endif
+#include "FactoryPresets.h" // generated by MiniSynthPresetCompiler
+#include "diag/TraceRecorder.h"
 
 using namespace juce;
 
@@ -27,32 +23,36 @@ PresetManager::PresetManager (AudioProcessorValueTreeState& s, String org, Strin
     rebuildList();
 }
 
-static bool isPresetResource (const char* name) {
-    auto str = String (name);
-    return str.endsWithIgnoreCase (".minisynth.json");
-}
-
 void PresetManager::rebuildList() {
     entries.clear();
+    std::vector<PresetIndex::Source> sources;
 
-   #if MS_HAVE_BINARYDATA
-    for (int i = 0; i < BinaryData::namedResourceListSize; ++i) {
-        const char* nm = BinaryData::namedResourceList[i];
-        if (! isPresetResource (nm)) continue;
-        auto e = new PresetEntry(); e->factory = true; e->resName = nm;
-        auto base = File (String (nm)).getFileNameWithoutExtension();
-        e->name = base.replace ("_", " ");
+    for (int i = 0; i < factory::numPresets; ++i) {
+        auto e = new PresetEntry(); e->factory = true; e->factoryIndex = i;
+        e->name = factory::list[i].name;
         entries.add (e);
+
+        // Factory meta is compiled in
+        PresetIndex::Source s;
+        s.info.name = e->name; s.info.author = factory::list[i].author; s.info.category = factory::list[i].category;
+        s.info.tags.addTokens (factory::list[i].tags, ",", "");
+        s.info.tags.removeEmptyStrings();
+        sources.push_back (std::move (s));
     }
-   #endif
 
-    // User folder
+    // User folder: "Name.minisynth.json" -> "Name", as save/delete expect
     auto dir = getUserDir(); dir.createDirectory();
     RangedDirectoryIterator it (dir, false, "*.minisynth.json;*.minisynth.xml");
     for (const auto& f : it) {
-        auto e = new PresetEntry(); e->factory = false; e->file = f.getFile(); e->name = e->file.getFileNameWithoutExtension();
+        auto e = new PresetEntry(); e->factory = false; e->file = f.getFile();
+        e->name = e->file.getFileName().upToFirstOccurrenceOf (".minisynth.", false, true);
         entries.add (e);
+
+        PresetIndex::Source s; s.info.name = e->name; s.file = e->file;
+        sources.push_back (std::move (s));
     }
+
+    searchIndex.rebuild (std::move (sources));
 }
 
 StringArray PresetManager::getAllPresetNames() const {
@@ -76,7 +76,7 @@ void PresetManager::applyJson (const String& jsonText) {
     for (auto& p : dyn->getProperties()) {
         auto id = p.name.toString();
         auto* param = apvts.getParameter (id);
-        if (! param) continue;
+        if (! param || ! param->isAutomatable()) continue; // read-only outputs are not preset state
 
         if (auto* f = dynamic_cast<AudioParameterFloat*> (param)) {
             float val = (float) p.value;
@@ -92,34 +92,86 @@ void PresetManager::applyJson (const String& jsonText) {
     }
 }
 
+void PresetManager::applyFactory (int factoryIndex) {
+    // Pre-validated and pre-normalised at build time: no parsing, lookup or allocation
+    const auto& preset = factory::list[factoryIndex];
+    const auto& procParams = apvts.processor.getParameters();
+
+    for (int i = 0; i < preset.numValues; ++i) {
+        const auto& v = preset.values[i];
+        auto* param = procParams[v.index];
+        param->beginChangeGesture(); param->setValueNotifyingHost (v.norm); param->endChangeGesture();
+    }
+}
+
 void PresetManager::applyPresetByIndex (int index) {
     if (! isPositiveAndBelow (index, entries.size())) return;
+    MS_TRACE_SCOPE ("applyPreset", "preset", index);
+    auto* e = entries[index];
+
+    if (e->factory) applyFactory (e->factoryIndex);
+    else            applyFile (e->file);
+}
+
+bool PresetManager::applyFile (const File& file) {
+    auto text = file.loadFileAsString();
+    // Could be JSON or XML
+    if (text.trimStart().startsWithChar ('{')) {
+        applyJson (text);
+        return true;
+    }
+    if (auto xml = XmlDocument::parse (text)) {
+        apvts.replaceState (ValueTree::fromXml (*xml));
+        return true;
+    }
+    return false;
+}
+
+bool PresetManager::getNormalisedValues (int index, float* dest) const {
+    if (! isPositiveAndBelow (index, entries.size())) return false;
     auto* e = entries[index];
+    const auto& procParams = apvts.processor.getParameters();
+
+    // Parameters a preset does not mention take their default
+    for (int i = 0; i < params::count; ++i) dest[i] = procParams[i]->getDefaultValue();
 
     if (e->factory) {
-       #if MS_HAVE_BINARYDATA
-        int size = 0; auto* data = BinaryData::getNamedResource (e->resName.toRawUTF8(), size);
-        if (data && size > 0) applyJson (String::fromUTF8 ((const char*) data, size));
-       #endif
-    } else {
-        auto text = e->file.loadFileAsString();
-        // Could be JSON or XML
-        if (text.trimStart().startsWithChar ('{')) {
-            applyJson (text);
-        } else {
-            if (auto xml = XmlDocument::parse (text)) {
-                apvts.replaceState (ValueTree::fromXml (*xml));
-            }
-        }
+        const auto& preset = factory::list[e->factoryIndex];
+        for (int i = 0; i < preset.numValues; ++i) dest[preset.values[i].index] = preset.values[i].norm;
+        return true;
     }
+
+    auto overlay = [&] (const String& id, const var& value) {
+        if (auto* param = apvts.getParameter (id))
+            dest[param->getParameterIndex()] = param->convertTo0to1 ((float) value);
+    };
+
+    auto text = e->file.loadFileAsString();
+    if (text.trimStart().startsWithChar ('{')) {
+        auto* vals = JSON::parse (text).getProperty ("values", var()).getDynamicObject();
+        if (vals == nullptr) return false;
+        for (auto& p : vals->getProperties()) overlay (p.name.toString(), p.value);
+        return true;
+    }
+
+    auto xml = XmlDocument::parse (text);
+    if (xml == nullptr) return false;
+    auto tree = ValueTree::fromXml (*xml);
+    for (int i = 0; i < tree.getNumChildren(); ++i) {
+        auto child = tree.getChild (i);
+        if (child.hasProperty ("id")) overlay (child["id"].toString(), child["value"]);
+    }
+    return true;
 }
 
 bool PresetManager::saveUserPreset (const String& name) {
     auto dir = getUserDir(); dir.createDirectory();
     auto f = dir.getChildFile (name + ".minisynth.xml");
     auto st = apvts.copyState();
-    if (auto xml = st.createXml()) return xml->writeTo (f);
-    return false;
+    auto xml = st.createXml();
+    const bool ok = xml != nullptr && xml->writeTo (f);
+    rebuildList();
+    return ok;
 }
 
 bool PresetManager::deleteUserPreset (const String& name) {
@@ -10,6 +10,8 @@
 
 #pragma once
 #include "JuceIncludes.h"
+#include "ParameterSpecs.h"
+#include "PresetIndex.h"
 
 namespace presets {
 
@@ -18,23 +20,32 @@ public:
     PresetManager (juce::AudioProcessorValueTreeState& s, juce::String org, juce::String app);
 
     juce::StringArray getAllPresetNames() const; // factory + user
+    // Search over the same list (same indices); meta of user files is indexed in the background
+    const PresetIndex& getIndex() const { return searchIndex; }
     bool isFactoryIndex (int index) const;
     void applyPresetByIndex (int index);
+    // User preset outside the list (*.minisynth.json or APVTS XML); false if unreadable
+    bool applyFile (const juce::File& file);
+    // Full normalised vector (params::count values, spec order) without touching the
+    // APVTS; parameters the preset omits are set to their defaults.
+    bool getNormalisedValues (int index, float* dest) const;
 
     bool saveUserPreset (const juce::String& name);
     bool deleteUserPreset (const juce::String& name);
     juce::File getUserDir() const;
 
 private:
-    struct PresetEntry { juce::String name; bool factory = false; juce::String resName; juce::File file; };
+    struct PresetEntry { juce::String name; bool factory = false; int factoryIndex = -1; juce::File file; };
 
     juce::AudioProcessorValueTreeState& apvts;
     juce::String organisation, application;
 
     juce::OwnedArray<PresetEntry> entries; // filled at construction
+    PresetIndex searchIndex;
 
     void rebuildList();
     void applyJson (const juce::String& jsonText);
+    void applyFactory (int factoryIndex);
 };
 
 } // namespace presets
@@ -0,0 +1,73 @@
+/*
+    File: PresetMorph.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        A/B preset morph implementation. The per-block blend is two vectorised
+        multiply-adds over the whole parameter vector followed by a single
+        normalised-to-plain conversion pass.
+*/
+
+#include "PresetMorph.h"
+
+using namespace juce;
+
+namespace presets {
+
+PresetMorph::PresetMorph() {
+    for (int i = 0; i < params::count; ++i) {
+        const auto& s = params::specs[i];
+        if (s.kind == params::Kind::Float)
+            ranges[i] = NormalisableRange<float> (s.start, s.end, s.interval, s.skew);
+        morphable[i] = true;
+    }
+
+    // Performance settings and the morph controls themselves are never morphed
+    for (int i : { params::idx::mpeEnabled, params::idx::bendRange, params::idx::morphOn, params::idx::morph,
+                   params::idx::ecoOn, params::idx::ecoMaxTier })
+        morphable[i] = false;
+}
+
+void PresetMorph::setSlot (Slot slot, const float* normalised) {
+    const SpinLock::ScopedLockType sl (lock);
+    FloatVectorOperations::copy (slots[slot], normalised, params::count);
+    hasSlot[slot] = true;
+    rebuildDeltas();
+    ready.store (hasSlot[A] && hasSlot[B]);
+}
+
+void PresetMorph::rebuildDeltas() {
+    for (int i = 0; i < params::count; ++i) {
+        const float d = slots[B][i] - slots[A][i];
+        const bool stepped = params::specs[i].kind != params::Kind::Float;
+        lerpDelta[i] = stepped ? 0.0f : d;
+        stepDelta[i] = stepped ? d : 0.0f;
+    }
+}
+
+bool PresetMorph::process (float amount, params::Block& block) {
+    if (! ready.load()) return false;
+
+    const float t = jlimit (0.0f, 1.0f, amount);
+    {
+        const SpinLock::ScopedTryLockType sl (lock);
+        if (sl.isLocked()) {
+            FloatVectorOperations::copy (blend, slots[A], params::count);
+            FloatVectorOperations::addWithMultiply (blend, lerpDelta, t, params::count);
+            FloatVectorOperations::addWithMultiply (blend, stepDelta, t >= 0.5f ? 1.0f : 0.0f, params::count);
+            haveBlend = true;
+        }
+    }
+    if (! haveBlend) return false;
+
+    for (int i = 0; i < params::count; ++i) {
+        if (! morphable[i]) continue;
+        const auto& s = params::specs[i];
+        block.values[i] = s.kind == params::Kind::Float ? ranges[i].convertFrom0to1 (blend[i])
+                                                        : std::round (blend[i] * s.end);
+    }
+    return true;
+}
+
+} // namespace presets
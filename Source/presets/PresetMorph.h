@@ -0,0 +1,51 @@
+/*
+    File: PresetMorph.h
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        A/B preset morph. Holds two presets as normalised vectors and, once per
+        block, blends them straight into the processor's params::Block (no host
+        notification): continuous parameters are lerped, bool/choice ones
+        switch at the midpoint.
+*/
+
+#pragma once
+#include "JuceIncludes.h"
+#include "ParameterSpecs.h"
+
+namespace presets {
+
+class PresetMorph {
+public:
+    enum Slot { A = 0, B = 1 };
+
+    PresetMorph();
+
+    // Message thread. 'normalised' holds params::count values in spec order.
+    void setSlot (Slot slot, const float* normalised);
+    bool isReady() const { return ready.load(); }
+
+    // Audio thread. Overwrites the morphable entries of 'block' with the blend at
+    // 'amount' (0 = A, 1 = B). Returns false (block untouched) until both slots are set.
+    bool process (float amount, params::Block& block);
+
+private:
+    void rebuildDeltas();
+
+    // Written under 'lock' by setSlot; the audio thread only try-locks and keeps
+    // the previous blend if the tables are being replaced.
+    juce::SpinLock lock;
+    alignas (16) float slots[2][params::count] {};
+    alignas (16) float lerpDelta[params::count] {}; // B - A for continuous params, 0 otherwise
+    alignas (16) float stepDelta[params::count] {}; // B - A for bool/choice params, 0 otherwise
+    bool hasSlot[2] { false, false };
+    std::atomic<bool> ready { false };
+
+    alignas (16) float blend[params::count] {};     // audio thread only
+    bool haveBlend = false;
+    juce::NormalisableRange<float> ranges[params::count];
+    bool morphable[params::count] {};
+};
+
+} // namespace presets
@@ -0,0 +1,202 @@
+/*
+    File: Alias.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Oscillator quality survey. Each waveform (noise excluded) is played
+        through SynthVoice alone (osc1 only, no unison/sub/LFOs, filter set to
+        HP at 20 Hz, i.e. flat) across the MIDI range at 44.1, 48 and 96 kHz.
+        The steady-state output is FFT'd with a Blackman-Harris window: power
+        within a few bins of a true harmonic (k * f0 < fs/2) is signal,
+        everything else above 20 Hz is alias. Reports the alias-to-signal
+        ratio (whole band and below 20 kHz) and the render cost per sample.
+
+        --upsampler instead checks PolyphaseUpsampler in isolation: sines up to
+        20 kHz at a 48 kHz engine rate, upsampled to 88.2, 96, 176.4 and
+        192 kHz in random block sizes, against the ideal signal delayed by
+        the filter's exact group delay (exit status 1 above 2e-4).
+
+        Usage: MiniSynthAlias [--notes <first> <last> <step>] [--csv <file>]
+               MiniSynthAlias --upsampler
+               defaults: notes 24..120 step 6
+*/
+
+#include "JuceIncludes.h"
+#include "dsp/SynthVoice.h"
+#include "dsp/SharedTables.h"
+#include "dsp/PolyphaseUpsampler.h"
+#include <chrono>
+#include <iostream>
+#include <numeric>
+
+using namespace juce;
+
+namespace {
+
+constexpr int fftOrder = 16, fftSize = 1 << fftOrder;
+constexpr int chunk = 256;
+constexpr int harmonicHalfWidth = 6; // bins, covers the Blackman-Harris main lobe
+
+struct Measurement { double asrDb, audibleAsrDb, nsPerSample; };
+
+params::Block bareOscillator (int wave) {
+    params::Block b;
+    for (int i = 0; i < params::count; ++i) b.values[i] = params::specs[i].def;
+
+    auto set = [&b] (int index, float v) { b.values[index] = v; };
+    set (params::idx::osc1Wave, (float) wave);
+    set (params::idx::mix1, 1.0f); set (params::idx::mix2, 0.0f); set (params::idx::mix3, 0.0f);
+    set (params::idx::detune1, 0.0f); set (params::idx::stereoSpread, 0.0f);
+    set (params::idx::uniOn, 0.0f); set (params::idx::subOn, 0.0f);
+    set (params::idx::mixNoiseW, 0.0f); set (params::idx::mixNoiseP, 0.0f); set (params::idx::mixNoiseB, 0.0f);
+    set (params::idx::pwm1, 0.5f); set (params::idx::pwmDepth1, 0.0f);
+    set (params::idx::attack, 0.001f); set (params::idx::decay, 0.001f); set (params::idx::sustain, 1.0f);
+    set (params::idx::filterType, 2.0f); set (params::idx::cutoff, 20.0f); set (params::idx::resonance, 0.707f);
+    set (params::idx::fAmt, 0.0f);
+    set (params::idx::lfoTarget, 0.0f); set (params::idx::lfo2Target, 0.0f);
+    set (params::idx::sync2to1, 0.0f); set (params::idx::sync3to1, 0.0f);
+    set (params::idx::fm31, 0.0f); set (params::idx::fm32, 0.0f);
+    set (params::idx::gain, 0.0f); set (params::idx::morphOn, 0.0f);
+    return b;
+}
+
+Measurement measure (int wave, int note, double sampleRate, const DspTables& tables) {
+    const auto values = bareOscillator (wave);
+    SynthVoice voice (values);
+    voice.prepare (sampleRate, chunk, 2, tables);
+    voice.setNoiseSeed (1);
+    voice.queueEvent ({ 0, SynthVoice::Event::NoteOn, note, 1.0f });
+
+    // Skip the attack and the filter settling, then time the analysed stretch
+    AudioBuffer<float> audio (2, fftSize);
+    for (int i = 0; i < (int) (0.1 * sampleRate) / chunk; ++i) {
+        audio.clear (0, chunk);
+        voice.renderNextBlock (audio, 0, chunk);
+    }
+    audio.clear();
+    const auto start = std::chrono::steady_clock::now();
+    for (int pos = 0; pos < fftSize; pos += chunk) voice.renderNextBlock (audio, pos, chunk);
+    const double ns = std::chrono::duration<double, std::nano> (std::chrono::steady_clock::now() - start).count() / fftSize;
+
+    std::vector<float> spectrum ((size_t) fftSize * 2, 0.0f);
+    std::copy_n (audio.getReadPointer (0), fftSize, spectrum.begin());
+    dsp::WindowingFunction<float> window ((size_t) fftSize, dsp::WindowingFunction<float>::blackmanHarris, false);
+    window.multiplyWithWindowingTable (spectrum.data(), (size_t) fftSize);
+    dsp::FFT (fftOrder).performFrequencyOnlyForwardTransform (spectrum.data());
+
+    const double binHz = sampleRate / fftSize;
+    const double f0 = tables.noteHz[note];
+    double signal = 0.0, alias = 0.0, audibleAlias = 0.0;
+    for (int k = (int) std::ceil (20.0 / binHz); k <= fftSize / 2; ++k) {
+        const double hz = k * binHz;
+        const double harmonic = std::round (hz / f0);
+        const bool isHarmonic = harmonic >= 1.0 && harmonic * f0 < 0.5 * sampleRate
+                             && std::abs (hz - harmonic * f0) <= harmonicHalfWidth * binHz;
+        const double power = (double) spectrum[(size_t) k] * spectrum[(size_t) k];
+        if (isHarmonic) signal += power;
+        else { alias += power; if (hz < 20000.0) audibleAlias += power; }
+    }
+
+    auto ratioDb = [signal] (double p) { return 10.0 * std::log10 (jmax (p, 1.0e-30) / jmax (signal, 1.0e-30)); };
+    return { ratioDb (alias), ratioDb (audibleAlias), ns };
+}
+
+// Worst |output - ideal| per output rate and sine; true when all are within tolerance
+bool checkUpsampler() {
+    constexpr double inRate = 48000.0, amplitude = 0.5, tolerance = 2.0e-4;
+    constexpr int maxOut = 1024;
+    Random rng (1);
+    bool pass = true;
+
+    std::cout << "upsampler  out rate   worst error at 100 Hz .. 20 kHz" << std::endl;
+    for (double outRate : { 88200.0, 96000.0, 176400.0, 192000.0 }) {
+        String line;
+        for (double hz : { 100.0, 1000.0, 5000.0, 10000.0, 15000.0, 18000.0, 20000.0 }) {
+            PolyphaseUpsampler up;
+            up.prepare (inRate, outRate, maxOut, 1);
+
+            // Output m sits at input time m * M / L, behind by the prototype's centre tap
+            const int g = std::gcd ((int) inRate, (int) outRate), L = (int) outRate / g, M = (int) inRate / g;
+            const double delay = 0.5 * (PolyphaseUpsampler::tapsPerPhase * L - 1) / M;
+            const int64 settle = 4 * up.getLatencySamples(); // skip the start-up transient
+
+            AudioBuffer<float> in (1, up.getMaxInput()), out (1, maxOut);
+            int64 inPos = 0, outPos = 0;
+            double worst = 0.0;
+            while (outPos < (int64) outRate) {
+                const int n = 1 + rng.nextInt (maxOut), need = up.getInputNeeded (n);
+                for (int i = 0; i < need; ++i)
+                    in.setSample (0, i, (float) (amplitude * std::sin (MathConstants<double>::twoPi * hz * (double) (inPos + i) / inRate)));
+                up.process (in, need, out, 0, n);
+                for (int i = 0; i < n; ++i) {
+                    const int64 m = outPos + i;
+                    if (m < settle) continue;
+                    const double ideal = amplitude * std::sin (MathConstants<double>::twoPi * hz * ((double) m - delay) / outRate);
+                    worst = jmax (worst, std::abs ((double) out.getSample (0, i) - ideal));
+                }
+                inPos += need; outPos += n;
+            }
+            pass = pass && worst <= tolerance;
+            line << String (worst, 6).paddedLeft (' ', 10);
+        }
+        std::cout << "           " << String ((int) outRate).paddedRight (' ', 8) << line << std::endl;
+    }
+    std::cout << (pass ? "pass" : "FAIL") << " (tolerance " << tolerance << ")" << std::endl;
+    return pass;
+}
+
+String option (const StringArray& args, const char* name, int offset = 1) {
+    const int i = args.indexOf (name);
+    return i >= 0 && i + offset < args.size() ? args[i + offset] : String();
+}
+
+} // namespace
+
+int main (int argc, char* argv[]) {
+    StringArray args;
+    for (int i = 1; i < argc; ++i) args.add (argv[i]);
+    if (args.contains ("--upsampler")) return checkUpsampler() ? 0 : 1;
+
+    int first = 24, last = 120, step = 6;
+    if (args.contains ("--notes")) {
+        first = jlimit (0, 127, option (args, "--notes", 1).getIntValue());
+        last  = jlimit (first, 127, option (args, "--notes", 2).getIntValue());
+        step  = jmax (1, option (args, "--notes", 3).getIntValue());
+    }
+
+    const auto waves = StringArray::fromTokens (params::waveChoices, "|", "");
+    const double rates[] = { 44100.0, 48000.0, 96000.0 };
+
+    String csv ("wave,rate,note,hz,asr_db,audible_asr_db,ns_per_sample\n");
+    std::cout << "wave    rate    worst ASR  mean ASR  worst <20k  ns/sample   (dB, alias power / harmonic power)" << std::endl;
+
+    for (int w = 0; w < waves.size(); ++w) {
+        if (w == 4) continue; // white noise has no harmonics to measure against
+
+        for (double rate : rates) {
+            const auto tables = SharedTables::acquire (rate);
+            double worst = -1.0e9, worstAudible = -1.0e9, sum = 0.0, ns = 0.0;
+            int count = 0;
+
+            for (int note = first; note <= last; note += step) {
+                const auto m = measure (w, note, rate, *tables);
+                worst = jmax (worst, m.asrDb); worstAudible = jmax (worstAudible, m.audibleAsrDb);
+                sum += m.asrDb; ns += m.nsPerSample; ++count;
+                csv << waves[w] << "," << (int) rate << "," << note << "," << String (tables->noteHz[note], 2) << ","
+                    << String (m.asrDb, 2) << "," << String (m.audibleAsrDb, 2) << "," << String (m.nsPerSample, 2) << "\n";
+            }
+
+            std::cout << waves[w].paddedRight (' ', 8) << String ((int) rate).paddedRight (' ', 6)
+                      << String (worst, 1).paddedLeft (' ', 11) << String (sum / count, 1).paddedLeft (' ', 10)
+                      << String (worstAudible, 1).paddedLeft (' ', 12) << String (ns / count, 1).paddedLeft (' ', 11) << std::endl;
+        }
+    }
+
+    if (args.contains ("--csv")) {
+        const auto f = File::getCurrentWorkingDirectory().getChildFile (option (args, "--csv"));
+        if (! f.replaceWithText (csv)) { std::cerr << "error: cannot write " << f.getFullPathName() << std::endl; return 1; }
+        std::cout << "per-note results: " << f.getFullPathName() << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,211 @@
+/*
+    File: Bench.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Micro-benchmarks for the DSP kernels (PolyBLEPOsc, PulseOsc rounded and
+        plain, NoiseBus, TptSvf, ADSR) and for full SynthVoice::renderNextBlock
+        per waveform, unison on/off, 1/8/64 voices and block sizes 16..4096.
+        Prints a table and writes JSON so runs can be diffed between commits.
+        Each figure is the best of several timed runs, in ns per sample.
+
+        Usage: MiniSynthBench [--out bench.json] [--rate 48000] [--quick] [--filter <text>]
+*/
+
+#include "JuceIncludes.h"
+#include "dsp/VoiceArena.h"
+#include "dsp/SharedTables.h"
+#include <chrono>
+#include <iostream>
+
+using namespace juce;
+
+namespace {
+
+volatile float sink = 0.0f; // keeps results observable so loops are not optimised away
+
+struct Options { double sampleRate = 48000.0; double minSeconds = 0.02; int runs = 5; String filter; };
+
+// Best-of-runs ns per sample; 'fn' processes 'samplesPerCall' samples per call
+template <typename Fn>
+double measure (const Options& o, int samplesPerCall, Fn&& fn) {
+    using clock = std::chrono::steady_clock;
+    for (int i = 0; i < 3; ++i) fn(); // warm caches and branch predictors
+
+    double best = std::numeric_limits<double>::max();
+    for (int r = 0; r < o.runs; ++r) {
+        int64 calls = 0;
+        const auto start = clock::now();
+        double elapsed = 0.0;
+        do {
+            fn(); ++calls;
+            elapsed = std::chrono::duration<double> (clock::now() - start).count();
+        } while (elapsed < o.minSeconds);
+        best = jmin (best, elapsed * 1.0e9 / (double) (calls * samplesPerCall));
+    }
+    return best;
+}
+
+params::Block defaultBlock() {
+    params::Block b;
+    for (int i = 0; i < params::count; ++i) b.values[i] = params::specs[i].def;
+    return b;
+}
+
+struct Bench {
+    Options o;
+    std::shared_ptr<const DspTables> tables;
+    Array<var> kernels, voices;
+
+    bool wanted (const String& name) const { return o.filter.isEmpty() || name.containsIgnoreCase (o.filter); }
+
+    void kernel (const String& name, std::function<float()> sample) {
+        if (! wanted (name)) return;
+        constexpr int n = 512;
+        const double ns = measure (o, n, [&] { float acc = 0.0f; for (int i = 0; i < n; ++i) acc += sample(); sink = acc; });
+
+        auto* obj = new DynamicObject();
+        obj->setProperty ("name", name);
+        obj->setProperty ("nsPerSample", ns);
+        kernels.add (var (obj));
+        std::cout << name.paddedRight (' ', 32) << String (ns, 2).paddedLeft (' ', 10) << " ns/sample" << std::endl;
+    }
+
+    void runKernels() {
+        const dsp::ProcessSpec spec { o.sampleRate, 512, 1 };
+
+        PolyBLEPOsc saw; saw.prepare (spec); saw.setFrequency (440.0);
+        kernel ("PolyBLEPOsc.sawUp", [&] { return saw.processSample(); });
+
+        PulseOsc pulse; pulse.prepare (spec); pulse.setFrequency (440.0); pulse.setPulseWidth (0.3f);
+        pulse.setRoundedEdges (true);
+        kernel ("PulseOsc.rounded", [&] { return pulse.processSample(); });
+        PulseOsc plain; plain.prepare (spec); plain.setFrequency (440.0); plain.setPulseWidth (0.3f);
+        plain.setRoundedEdges (false);
+        kernel ("PulseOsc.unrounded", [&] { return plain.processSample(); });
+
+        TableOsc sine; sine.prepare (*tables); sine.setFrequency (440.0f);
+        kernel ("TableOsc.sine", [&] { return sine.processSample(); });
+
+        NoiseBus noise; noise.seed (1);
+        kernel ("NoiseBus.white", [&] { return noise.white(); });
+        kernel ("NoiseBus.pink",  [&] { return noise.pink(); });
+        kernel ("NoiseBus.brown", [&] { return noise.brown(); });
+
+        TptSvf svf; svf.reset(); svf.setCoefficients (tables->prewarpLog2 (std::log2 (2000.0f)), 0.9f);
+        float x = 0.0f;
+        kernel ("TptSvf.fixed", [&] { x = x * -0.99f + 0.5f; return svf.processSample (0, x); });
+        float sweep = 0.0f;
+        kernel ("TptSvf.modulated", [&] {
+            sweep += 0.001f; if (sweep > 1.0f) sweep = 0.0f;
+            svf.setCoefficients (tables->prewarpLog2 (8.0f + 6.0f * sweep), 0.9f);
+            x = x * -0.99f + 0.5f; return svf.processSample (0, x);
+        });
+
+        ADSR env; env.setSampleRate (o.sampleRate); env.setParameters ({ 0.01f, 0.1f, 0.7f, 0.2f });
+        int count = 0;
+        kernel ("ADSR.getNextSample", [&] {
+            if ((count++ & 8191) == 0) env.noteOn(); // keep cycling through attack/decay/sustain
+            return env.getNextSample();
+        });
+    }
+
+    void runVoices() {
+        const auto waves = StringArray::fromTokens (params::waveChoices, "|", "");
+        const bool quick = o.minSeconds < 0.01;
+        Array<int> blockSizes;
+        for (int b = 16; b <= 4096; b *= 2) if (! quick || b == 16 || b == 256 || b == 4096) blockSizes.add (b);
+
+        std::cout << std::endl << "wave    unison voices block   ns/sample  ns/voice-sample" << std::endl;
+
+        for (int w = 0; w < waves.size(); ++w)
+            for (bool unison : { false, true })
+                for (int numVoices : { 1, 8, 64 })
+                    for (int block : blockSizes) {
+                        const auto name = "SynthVoice." + waves[w] + (unison ? ".unison" : "") + "." + String (numVoices) + "v." + String (block);
+                        if (! wanted (name)) continue;
+
+                        params::Block values = defaultBlock();
+                        values.values[params::idx::osc1Wave] = values.values[params::idx::osc2Wave]
+                                                             = values.values[params::idx::osc3Wave] = (float) w;
+                        values.values[params::idx::uniOn] = unison ? 1.0f : 0.0f;
+
+                        VoiceArena pool (numVoices, values); // same layout as VoiceManager
+                        for (int v = 0; v < numVoices; ++v) {
+                            pool[v].prepare (o.sampleRate, block, 2, *tables);
+                            pool[v].setNoiseSeed (v + 1);
+                            pool[v].queueEvent ({ 0, SynthVoice::Event::NoteOn, 36 + (v * 7) % 60, 0.8f });
+                        }
+                        AudioBuffer<float> out (2, block);
+
+                        const double ns = measure (o, block, [&] {
+                            out.clear();
+                            for (auto& voice : pool) voice.renderNextBlock (out, 0, block);
+                            sink = out.getSample (0, block - 1);
+                        });
+
+                        auto* obj = new DynamicObject();
+                        obj->setProperty ("wave", waves[w]);
+                        obj->setProperty ("unison", unison);
+                        obj->setProperty ("voices", numVoices);
+                        obj->setProperty ("block", block);
+                        obj->setProperty ("nsPerSample", ns);
+                        obj->setProperty ("nsPerVoiceSample", ns / numVoices);
+                        voices.add (var (obj));
+
+                        std::cout << waves[w].paddedRight (' ', 8) << String (unison ? "on" : "off").paddedRight (' ', 7)
+                                  << String (numVoices).paddedLeft (' ', 6) << String (block).paddedLeft (' ', 6)
+                                  << String (ns, 1).paddedLeft (' ', 12) << String (ns / numVoices, 2).paddedLeft (' ', 17) << std::endl;
+                    }
+    }
+
+    var toJson() const {
+        auto* meta = new DynamicObject();
+        meta->setProperty ("date", Time::getCurrentTime().toISO8601 (true));
+        meta->setProperty ("cpu", SystemStats::getCpuModel());
+        meta->setProperty ("os", SystemStats::getOperatingSystemName());
+        meta->setProperty ("sampleRate", o.sampleRate);
+       #if JUCE_DEBUG
+        meta->setProperty ("build", "debug");
+       #else
+        meta->setProperty ("build", "release");
+       #endif
+
+        auto* root = new DynamicObject();
+        root->setProperty ("meta", var (meta));
+        root->setProperty ("kernels", kernels);
+        root->setProperty ("voice", voices);
+        return var (root);
+    }
+};
+
+String option (const StringArray& args, const char* name) {
+    const int i = args.indexOf (name);
+    return i >= 0 && i + 1 < args.size() ? args[i + 1] : String();
+}
+
+} // namespace
+
+int main (int argc, char* argv[]) {
+    StringArray args;
+    for (int i = 1; i < argc; ++i) args.add (argv[i]);
+
+    Bench bench;
+    if (args.contains ("--rate"))   bench.o.sampleRate = option (args, "--rate").getDoubleValue();
+    if (args.contains ("--filter")) bench.o.filter = option (args, "--filter");
+    if (args.contains ("--quick"))  { bench.o.minSeconds = 0.005; bench.o.runs = 3; }
+    if (bench.o.sampleRate < 8000.0) { std::cerr << "error: --rate must be >= 8000" << std::endl; return 1; }
+
+    const auto out = File::getCurrentWorkingDirectory().getChildFile (args.contains ("--out") ? option (args, "--out") : String ("bench.json"));
+
+    bench.tables = SharedTables::acquire (bench.o.sampleRate);
+    bench.runKernels();
+    bench.runVoices();
+
+    if (! out.replaceWithText (JSON::toString (bench.toJson()))) {
+        std::cerr << "error: cannot write " << out.getFullPathName() << std::endl; return 1;
+    }
+    std::cout << std::endl << "results: " << out.getFullPathName() << std::endl;
+    return 0;
+}
@@ -0,0 +1,308 @@
+/*
+    File: Golden.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Golden-audio regression check. Renders every factory preset through
+        MiniSynthAudioProcessor with a fixed MIDI phrase and fixed noise seeds
+        and compares the result with stored reference renders (32-bit float
+        WAV). Reports bit-exactness, max abs error and log-spectral distance
+        per preset; the exit status is non-zero if any preset is out of
+        tolerance, so CI can gate DSP rewrites on it, and 77 (skipped) when
+        the reference folder does not exist yet. Before the presets it
+        checks the Scala parser and compiler against known note tables
+        (12-TET round trip, a keyboard mapping with unmapped keys).
+
+        Usage:
+          MiniSynthGolden [--update] [--refs <dir>] [--presets <dir>] [--filter <text>]
+                          [--exact] [--max-abs <x>] [--max-lsd <dB>]
+
+        --update   (re)write the references instead of checking them
+        --refs     reference folder (Resources/Golden)
+        --presets  preset folder (Resources/Presets/Factory)
+        --exact    every sample must match bit for bit
+        --max-abs  largest allowed |render - reference| (1e-4)
+        --max-lsd  largest allowed mean log-spectral distance in dB (0.5)
+*/
+
+#include "JuceIncludes.h"
+#include "PluginProcessor.h"
+#include "dsp/Tuning.h"
+#include <iostream>
+
+using namespace juce;
+
+namespace {
+
+constexpr double sampleRate = 48000.0;
+constexpr int blockSize = 512;
+constexpr double tailSeconds = 1.5;
+constexpr int64 noiseSeed = 1;
+
+struct Tolerance { bool exact = false; double maxAbs = 1.0e-4, maxLsd = 0.5; };
+struct Result { bool identical; double maxAbs, lsd; };
+
+// Chord, release, a short line with velocity spread, pitch wheel and sustain pedal:
+// covers envelopes, voice reuse, bend routing and the release tails.
+MidiMessageSequence makePhrase() {
+    MidiMessageSequence seq;
+    auto add = [&seq] (double t, MidiMessage m) { m.setTimeStamp (t); seq.addEvent (m); };
+
+    for (int note : { 48, 55, 60, 64 }) add (0.0, MidiMessage::noteOn (1, note, (uint8) (70 + note / 4)));
+    for (int note : { 48, 55, 60, 64 }) add (1.0, MidiMessage::noteOff (1, note));
+
+    const int line[] = { 67, 69, 72, 74, 76, 79 };
+    for (int i = 0; i < 6; ++i) {
+        const double t = 1.25 + 0.2 * i;
+        add (t, MidiMessage::noteOn (1, line[i], (uint8) (30 + 16 * i)));
+        add (t + 0.15, MidiMessage::noteOff (1, line[i]));
+    }
+
+    add (2.6, MidiMessage::controllerEvent (1, 64, 127));
+    add (2.6, MidiMessage::noteOn (1, 36, (uint8) 100));
+    add (2.7, MidiMessage::noteOff (1, 36));
+    for (int i = 0; i <= 20; ++i) add (2.7 + 0.02 * i, MidiMessage::pitchWheel (1, 8192 + i * 300));
+    add (3.2, MidiMessage::pitchWheel (1, 8192));
+    add (3.4, MidiMessage::controllerEvent (1, 64, 0));
+
+    seq.updateMatchedPairs();
+    return seq;
+}
+
+bool render (const File& preset, const MidiMessageSequence& seq, AudioBuffer<float>& out) {
+    MiniSynthAudioProcessor proc;
+    proc.setNonRealtime (true);
+    proc.setPlayConfigDetails (0, 2, sampleRate, blockSize);
+    if (! proc.applyPresetFile (preset)) return false;
+
+    proc.prepareToPlay (sampleRate, blockSize);
+    proc.setNoiseSeed (noiseSeed);
+
+    const int total = (int) std::ceil ((seq.getEndTime() + tailSeconds) * sampleRate);
+    out.setSize (2, total);
+    MidiBuffer midi;
+    int next = 0;
+
+    for (int pos = 0; pos < total; pos += blockSize) {
+        const int n = jmin (blockSize, total - pos);
+        midi.clear();
+        for (; next < seq.getNumEvents(); ++next) {
+            const auto& m = seq.getEventPointer (next)->message;
+            const auto at = (int) std::llround (m.getTimeStamp() * sampleRate);
+            if (at >= pos + n) break;
+            midi.addEvent (m, jmax (0, at - pos));
+        }
+        AudioBuffer<float> block (out.getArrayOfWritePointers(), 2, pos, n);
+        proc.processBlock (block, midi);
+    }
+    proc.releaseResources();
+    return true;
+}
+
+// Mean over 2048-point Hann frames (hop 1024) of the RMS dB difference between
+// magnitude spectra, channels averaged. Bins far below the frame's peak are
+// floored so silence and noise-floor differences do not dominate.
+double logSpectralDistance (const AudioBuffer<float>& a, const AudioBuffer<float>& b) {
+    constexpr int order = 11, size = 1 << order, hop = size / 2;
+    dsp::FFT fft (order);
+    dsp::WindowingFunction<float> window ((size_t) size, dsp::WindowingFunction<float>::hann, false);
+    std::vector<float> fa ((size_t) size * 2), fb ((size_t) size * 2);
+
+    double sum = 0.0;
+    int frames = 0;
+    const int length = jmin (a.getNumSamples(), b.getNumSamples());
+    for (int ch = 0; ch < 2; ++ch)
+        for (int pos = 0; pos + size <= length; pos += hop) {
+            std::fill (fa.begin(), fa.end(), 0.0f);
+            std::fill (fb.begin(), fb.end(), 0.0f);
+            std::copy_n (a.getReadPointer (ch, pos), size, fa.begin());
+            std::copy_n (b.getReadPointer (ch, pos), size, fb.begin());
+            window.multiplyWithWindowingTable (fa.data(), (size_t) size);
+            window.multiplyWithWindowingTable (fb.data(), (size_t) size);
+            fft.performFrequencyOnlyForwardTransform (fa.data());
+            fft.performFrequencyOnlyForwardTransform (fb.data());
+
+            float peak = 0.0f;
+            for (int k = 0; k <= size / 2; ++k) peak = jmax (peak, fa[(size_t) k], fb[(size_t) k]);
+            const float floor = jmax (1.0e-7f, peak * 1.0e-5f); // -100 dB below the frame peak
+
+            double sq = 0.0;
+            for (int k = 0; k <= size / 2; ++k) {
+                const double d = 20.0 * std::log10 (jmax (fa[(size_t) k], floor) / jmax (fb[(size_t) k], floor));
+                sq += d * d;
+            }
+            sum += std::sqrt (sq / (size / 2 + 1));
+            ++frames;
+        }
+    return frames > 0 ? sum / frames : 0.0;
+}
+
+Result compare (const AudioBuffer<float>& render, const AudioBuffer<float>& ref) {
+    Result r { render.getNumSamples() == ref.getNumSamples(), 0.0, 0.0 };
+    const int length = jmin (render.getNumSamples(), ref.getNumSamples());
+    for (int ch = 0; ch < 2; ++ch) {
+        const auto* x = render.getReadPointer (ch);
+        const auto* y = ref.getReadPointer (ch);
+        for (int i = 0; i < length; ++i) {
+            if (std::memcmp (x + i, y + i, sizeof (float)) != 0) r.identical = false;
+            r.maxAbs = jmax (r.maxAbs, (double) std::abs (x[i] - y[i]));
+        }
+    }
+    r.lsd = logSpectralDistance (render, ref);
+    return r;
+}
+
+bool writeWav (const File& f, const AudioBuffer<float>& audio) {
+    f.getParentDirectory().createDirectory();
+    f.deleteFile();
+    auto stream = std::make_unique<FileOutputStream> (f);
+    if (stream->failedToOpen()) return false;
+
+    WavAudioFormat wav;
+    std::unique_ptr<AudioFormatWriter> writer (wav.createWriterFor (stream.get(), sampleRate, 2, 32, {}, 0)); // 32 bit = float
+    if (writer == nullptr) return false;
+    stream.release();
+    return writer->writeFromAudioSampleBuffer (audio, 0, audio.getNumSamples());
+}
+
+bool readWav (const File& f, AudioBuffer<float>& audio) {
+    WavAudioFormat wav;
+    std::unique_ptr<AudioFormatReader> reader (wav.createReaderFor (f.createInputStream().release(), true));
+    if (reader == nullptr || reader->numChannels != 2 || reader->sampleRate != sampleRate) return false;
+
+    audio.setSize (2, (int) reader->lengthInSamples);
+    return reader->read (&audio, 0, (int) reader->lengthInSamples, 0, true, true);
+}
+
+// Scala parse + compile against note tables worked out by hand; failures counted
+int checkTuning() {
+    int failures = 0;
+    const auto report = [&failures] (const char* name, bool pass, const String& detail = {}) {
+        if (! pass) ++failures;
+        std::cout << (String ("tuning: ") + name).paddedRight (' ', 32)
+                  << (pass ? "pass" : "FAIL") << (detail.isNotEmpty() ? "  " + detail : String()) << std::endl;
+    };
+    // Worst relative error against 'expected' (hz) over keys [0, 127], log2Hz included
+    const auto worst = [] (const TuningTable& t, auto expected) {
+        double e = 0.0;
+        for (int k = 0; k < 128; ++k) {
+            const double hz = expected (k);
+            e = jmax (e, std::abs (t.hz[k] / hz - 1.0), std::abs (std::exp2 ((double) t.log2Hz[k]) / hz - 1.0));
+        }
+        return e;
+    };
+    const auto equalHz = [] (int k) { return 440.0 * std::exp2 ((k - 69) / 12.0); };
+
+    // 12-TET as cents and as a ratio period, default mapping: must give back TuningTable::equal()
+    String twelve ("! 12-TET.scl\n12-TET round trip\n 12\n!\n");
+    for (int i = 1; i < 12; ++i) twelve << (100 * i) << ".0\n";
+    twelve << "2/1\n";
+    Scala::Scale scale; Scala::Mapping mapping; String error;
+    if (! Scala::parseScale (twelve, scale, error)) report ("12-TET parse", false, error);
+    else {
+        const auto e = worst (*Scala::compile (scale, mapping), equalHz);
+        report ("12-TET round trip", e < 1.0e-5, "max rel error " + String (e, 8));
+    }
+
+    // 24-TET, white keys mapped to degree (key - 60) mod 12, black keys unmapped ('x'),
+    // keys 36..96 only: mapped keys move, the rest keep 12-TET. A4 is degree 9 = 450 cents.
+    String quarter ("! 24-TET.scl\n24-TET\n24\n");
+    for (int i = 1; i <= 24; ++i) quarter << (50 * i) << ".0\n";
+    const String kbm ("! white.kbm\n12\n36\n96\n60\n69\n440.0\n24\n0\nx\n2\nx\n4\n5\nx\n7\nx\n9\nx\n11\n");
+    Scala::Scale scale24; Scala::Mapping white;
+    if (! Scala::parseScale (quarter, scale24, error) || ! Scala::parseMapping (kbm, white, error)) report ("kbm parse", false, error);
+    else {
+        const auto e = worst (*Scala::compile (scale24, white), [&] (int k) {
+            const int offset = k - 60, octave = offset >= 0 ? offset / 12 : -((11 - offset) / 12), degree = offset - 12 * octave;
+            const bool mapped = k >= 36 && k <= 96 && degree != 1 && degree != 3 && degree != 6 && degree != 8 && degree != 10;
+            return mapped ? 440.0 * std::exp2 ((1200.0 * octave + 50.0 * degree - 450.0) / 1200.0) : equalHz (k);
+        });
+        report ("kbm unmapped keys", e < 1.0e-5, "max rel error " + String (e, 8));
+    }
+
+    // Malformed files are rejected with a message
+    Scala::Scale bad; Scala::Mapping badMap;
+    report ("short scale rejected", ! Scala::parseScale ("short\n3\n100.0\n", bad, error) && error.isNotEmpty());
+    error.clear();
+    report ("short kbm rejected", ! Scala::parseMapping ("12\n0\n127\n60\n69\n", badMap, error) && error.isNotEmpty());
+    return failures;
+}
+
+String option (const StringArray& args, const char* name) {
+    const int i = args.indexOf (name);
+    return i >= 0 && i + 1 < args.size() ? args[i + 1] : String();
+}
+
+} // namespace
+
+// CTest SKIP_RETURN_CODE: the reference folder does not exist
+constexpr int skippedExitCode = 77;
+
+int main (int argc, char* argv[]) {
+    const ScopedJuceInitialiser_GUI juceInit; // the processor's APVTS expects a message manager
+
+    StringArray args;
+    for (int i = 1; i < argc; ++i) args.add (argv[i]);
+
+    const auto cwd = File::getCurrentWorkingDirectory();
+    const auto refs = cwd.getChildFile (args.contains ("--refs") ? option (args, "--refs") : String ("Resources/Golden"));
+    const auto presetDir = cwd.getChildFile (args.contains ("--presets") ? option (args, "--presets") : String ("Resources/Presets/Factory"));
+    const bool update = args.contains ("--update");
+    const auto filter = option (args, "--filter");
+
+    Tolerance tol;
+    tol.exact = args.contains ("--exact");
+    if (args.contains ("--max-abs")) tol.maxAbs = option (args, "--max-abs").getDoubleValue();
+    if (args.contains ("--max-lsd")) tol.maxLsd = option (args, "--max-lsd").getDoubleValue();
+
+    auto presets = presetDir.findChildFiles (File::findFiles, false, "*.minisynth.json");
+    presets.sort();
+    if (presets.isEmpty()) { std::cerr << "error: no presets in " << presetDir.getFullPathName() << std::endl; return 1; }
+
+    const auto phrase = makePhrase();
+    int failures = update ? 0 : checkTuning();
+
+    // No reference set recorded yet: the tuning checks still count, the renders are skipped
+    if (! update && ! refs.isDirectory()) {
+        if (failures > 0) { std::cout << failures << " check(s) failed" << std::endl; return 1; }
+        std::cout << "skipped: no references in " << refs.getFullPathName() << " (record them with --update)" << std::endl;
+        return skippedExitCode;
+    }
+
+    for (const auto& preset : presets) {
+        const auto name = preset.getFileName().upToFirstOccurrenceOf (".", false, false);
+        if (filter.isNotEmpty() && ! name.containsIgnoreCase (filter)) continue;
+
+        AudioBuffer<float> audio;
+        if (! render (preset, phrase, audio)) {
+            std::cerr << name << ": error: cannot load preset" << std::endl; ++failures; continue;
+        }
+
+        const auto refFile = refs.getChildFile (name + ".wav");
+        if (update) {
+            if (writeWav (refFile, audio)) std::cout << name << ": reference written" << std::endl;
+            else { std::cerr << name << ": error: cannot write " << refFile.getFullPathName() << std::endl; ++failures; }
+            continue;
+        }
+
+        AudioBuffer<float> ref;
+        if (! readWav (refFile, ref)) {
+            std::cerr << name << ": error: no usable reference " << refFile.getFullPathName() << " (run with --update)" << std::endl;
+            ++failures; continue;
+        }
+
+        const auto r = compare (audio, ref);
+        const bool pass = tol.exact ? r.identical
+                                    : audio.getNumSamples() == ref.getNumSamples() && r.maxAbs <= tol.maxAbs && r.lsd <= tol.maxLsd;
+        if (! pass) ++failures;
+
+        std::cout << name.paddedRight (' ', 24) << (pass ? "pass" : "FAIL")
+                  << (r.identical ? "  bit-exact" : "  differs  ")
+                  << "  max abs " << String (r.maxAbs, 7) << "  lsd " << String (r.lsd, 3) << " dB"
+                  << (audio.getNumSamples() != ref.getNumSamples() ? "  (length mismatch)" : "") << std::endl;
+    }
+
+    if (failures > 0) std::cout << failures << " check(s) failed" << std::endl;
+    return failures > 0 ? 1 : 0;
+}
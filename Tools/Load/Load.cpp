@@ -0,0 +1,378 @@
+/*
+    File: Load.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Multi-instance load test. Runs N MiniSynthAudioProcessor instances in
+        one process on a simulated real-time audio callback: every buffer
+        period (block / rate, paced by the wall clock) all instances must
+        render one block, spread over worker threads (optionally pinned one
+        per core). Each instance plays its own preset and a synthetic MIDI
+        part (chords, arpeggio or an MPE stream). A period whose work ends
+        after its deadline is a miss. Without --instances the count doubles
+        until a run fails, then a bisection finds the largest sustainable
+        count: miss rate <= --max-miss % and p99 period load <= --max-load.
+        Reports per run the period load, misses, each instance's share of a
+        core and resident memory per instance.
+
+        Usage: MiniSynthLoad [--instances N | --max N (256)] [--threads N (cpus)] [--pin]
+                             [--rate Hz (48000)] [--block n (256)] [--seconds s (5)]
+                             [--presets a,b,... (all factory)] [--midi chords|arp|mpe]
+                             [--max-load 0.85] [--max-miss 0] [--eco] [--json out.json]
+*/
+
+#include "JuceIncludes.h"
+#include "PluginProcessor.h"
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#if JUCE_LINUX
+ #include <unistd.h>
+#elif JUCE_MAC
+ #include <mach/mach.h>
+#endif
+
+using namespace juce;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    double sampleRate = 48000.0; int blockSize = 256; double seconds = 5.0;
+    int fixedInstances = 0, maxInstances = 256, threads = 1; bool pin = false, eco = false;
+    double maxLoad = 0.85, maxMissPercent = 0.0;
+    String midi = "chords";
+    StringArray presets;
+};
+
+// "--name value" pairs; empty when absent
+String option (const StringArray& args, const char* name) {
+    const int i = args.indexOf (name);
+    return i >= 0 && i + 1 < args.size() ? args[i + 1] : String();
+}
+
+int64 residentBytes() {
+   #if JUCE_LINUX
+    // statm: size resident shared ... in pages
+    const auto fields = StringArray::fromTokens (File ("/proc/self/statm").loadFileAsString(), true);
+    return fields[1].getLargeIntValue() * (int64) sysconf (_SC_PAGESIZE);
+   #elif JUCE_MAC
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    return task_info (mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t) &info, &count) == KERN_SUCCESS
+               ? (int64) info.resident_size : 0;
+   #else
+    return 0; // not measured on this platform
+   #endif
+}
+
+// Calls fn (k, offset) for every t = k * period + phase inside [pos, pos + n)
+template <typename Fn>
+void every (int64 period, int64 phase, int64 pos, int n, Fn&& fn) {
+    for (int64 k = pos <= phase ? 0 : (pos - phase + period - 1) / period; k * period + phase < pos + n; ++k)
+        fn (k, (int) (k * period + phase - pos));
+}
+
+// Synthetic part for one instance at 120 bpm, deterministic from its index
+struct Pattern {
+    enum Kind { Chords, Arp, Mpe };
+    Kind kind = Chords;
+    int root = 48;
+    int64 bar = 96000, pos = 0; // samples
+
+    void prepare (Kind k, int instance, double sampleRate) {
+        kind = k; root = 48 + (instance * 7) % 12; pos = 0;
+        bar = (int64) (2.0 * sampleRate);
+    }
+
+    int chordNote (int64 chord, int voice) const {
+        static constexpr int shape[] = { 0, 4, 7, 11 }, progression[] = { 0, 5, -3, 2 };
+        return root + progression[chord % 4] + shape[voice];
+    }
+
+    void fill (MidiBuffer& midi, int n, double sampleRate) {
+        midi.clear();
+        const int64 hold = bar * 19 / 20;
+        switch (kind) {
+            case Chords:
+                every (bar, 0, pos, n, [&] (int64 k, int at) { for (int v = 0; v < 4; ++v) midi.addEvent (MidiMessage::noteOn (1, chordNote (k, v), (uint8) 96), at); });
+                every (bar, hold, pos, n, [&] (int64 k, int at) { for (int v = 0; v < 4; ++v) midi.addEvent (MidiMessage::noteOff (1, chordNote (k, v)), at); });
+                break;
+
+            case Arp: { // sixteenths over two octaves, 80 % gate
+                static constexpr int steps[] = { 0, 4, 7, 12, 16, 12, 7, 4 };
+                const int64 step = bar / 16, gate = step * 4 / 5;
+                every (step, 0, pos, n, [&] (int64 k, int at) { midi.addEvent (MidiMessage::noteOn (1, root + 12 + steps[k % 8], (uint8) 100), at); });
+                every (step, gate, pos, n, [&] (int64 k, int at) { midi.addEvent (MidiMessage::noteOff (1, root + 12 + steps[k % 8]), at); });
+                break;
+            }
+
+            case Mpe: { // one chord note per member channel 2..5, plus per-note bend, pressure and timbre every block
+                every (bar, 0, pos, n, [&] (int64 k, int at) { for (int v = 0; v < 4; ++v) midi.addEvent (MidiMessage::noteOn (2 + v, chordNote (k, v), (uint8) 96), at); });
+                every (bar, hold, pos, n, [&] (int64 k, int at) { for (int v = 0; v < 4; ++v) midi.addEvent (MidiMessage::noteOff (2 + v, chordNote (k, v)), at); });
+                const double t = (double) pos / sampleRate;
+                for (int v = 0; v < 4; ++v) {
+                    const double lfo = std::sin (MathConstants<double>::twoPi * (5.0 * t + 0.25 * v));
+                    midi.addEvent (MidiMessage::pitchWheel (2 + v, 8192 + (int) (400.0 * lfo)), 0);
+                    midi.addEvent (MidiMessage::channelPressureChange (2 + v, 64 + (int) (40.0 * lfo)), 0);
+                    midi.addEvent (MidiMessage::controllerEvent (2 + v, 74, 64 - (int) (40.0 * lfo)), 0);
+                }
+                break;
+            }
+        }
+        pos += n;
+    }
+};
+
+struct Instance {
+    std::unique_ptr<MiniSynthAudioProcessor> proc;
+    Pattern pattern;
+    AudioBuffer<float> buffer;
+    MidiBuffer midi;
+};
+
+struct Result {
+    int instances = 0; int64 periods = 0, misses = 0;
+    double meanLoad = 0.0, p99Load = 0.0, worstLoad = 0.0; // of the period, across all workers
+    double instanceLoad = 0.0;                              // mean share of one core per instance
+    double bytesPerInstance = 0.0;
+};
+
+class Host {
+public:
+    explicit Host (const Options& opts) : o (opts) {
+        for (int i = 0; i < o.threads; ++i) workers.add (new Worker (*this, i));
+        for (auto* w : workers) w->startThread();
+    }
+
+    ~Host() {
+        for (auto* w : workers) w->signalThreadShouldExit();
+        for (auto* w : workers) { w->go.signal(); w->stopThread (2000); }
+        instances.clear();
+    }
+
+    // Creates, loads and prepares instances up to 'n' (message thread, outside the timed loop)
+    bool grow (int n, String& error) {
+        while ((int) instances.size() < n) {
+            auto inst = std::make_unique<Instance>();
+            inst->proc = std::make_unique<MiniSynthAudioProcessor>();
+            auto& proc = *inst->proc;
+
+            const auto names = proc.getPresetNames();
+            const auto wanted = o.presets.isEmpty() ? names : o.presets;
+            if (wanted.isEmpty()) { error = "no presets"; return false; }
+            const auto& name = wanted[(int) instances.size() % wanted.size()];
+            const int index = names.indexOf (name, true);
+            if (index < 0) { error = "unknown preset '" + name + "'"; return false; }
+            proc.applyPresetByIndex (index);
+            if (o.eco)
+                if (auto* p = proc.apvts.getParameter (ids::ecoOn)) p->setValueNotifyingHost (1.0f);
+
+            proc.setPlayConfigDetails (0, 2, o.sampleRate, o.blockSize);
+            proc.prepareToPlay (o.sampleRate, o.blockSize);
+            inst->buffer.setSize (2, o.blockSize);
+            inst->midi.ensureSize (4096);
+            inst->pattern.prepare (o.midi == "arp" ? Pattern::Arp : o.midi == "mpe" ? Pattern::Mpe : Pattern::Chords,
+                                   (int) instances.size(), o.sampleRate);
+            instances.push_back (std::move (inst));
+        }
+        return true;
+    }
+
+    Result run (int n) {
+        active = n;
+        const auto period = std::chrono::duration_cast<Clock::duration> (std::chrono::duration<double> (o.blockSize / o.sampleRate));
+        const auto warmup = (int64) std::ceil (0.5 * o.sampleRate / o.blockSize);
+        const auto periods = (int64) std::ceil (o.seconds * o.sampleRate / o.blockSize);
+
+        Result r;
+        r.instances = n;
+        std::vector<double> loads;
+        loads.reserve ((size_t) periods);
+
+        auto start = Clock::now();
+        for (int64 p = 0; p < warmup + periods; ++p) {
+            if (p == warmup)
+                for (int i = 0; i < n; ++i) instances[(size_t) i]->proc->resetDeadlineStats();
+
+            for (auto* w : workers) w->go.signal();
+            auto finish = start;
+            for (auto* w : workers) { w->done.wait(); finish = jmax (finish, w->finish); }
+
+            const double load = std::chrono::duration<double> (finish - start).count() / std::chrono::duration<double> (period).count();
+            if (p >= warmup) {
+                loads.push_back (load);
+                r.meanLoad += load;
+                r.worstLoad = jmax (r.worstLoad, load);
+                if (load > 1.0) ++r.misses;
+            }
+
+            // Next callback one period later; a late one starts immediately, as a driver would after a dropout
+            start += period;
+            if (Clock::now() < start) std::this_thread::sleep_until (start);
+            else start = Clock::now();
+        }
+
+        r.periods = (int64) loads.size();
+        r.meanLoad /= jmax ((int64) 1, r.periods);
+        std::sort (loads.begin(), loads.end());
+        if (! loads.empty()) r.p99Load = loads[(size_t) jmin ((int64) loads.size() - 1, (int64) std::ceil (0.99 * (double) loads.size()) - 1)];
+        for (int i = 0; i < n; ++i) r.instanceLoad += instances[(size_t) i]->proc->getDeadlineStats().meanLoad / n;
+        r.bytesPerInstance = (double) (residentBytes() - baseline) / (double) instances.size();
+        return r;
+    }
+
+    bool sustainable (const Result& r) const {
+        return 100.0 * (double) r.misses / (double) jmax ((int64) 1, r.periods) <= o.maxMissPercent && r.p99Load <= o.maxLoad;
+    }
+
+private:
+    // Renders instances index, index + threads, ... once per period
+    class Worker : public Thread {
+    public:
+        Worker (Host& h, int i) : Thread ("MiniSynthLoad worker " + String (i)), host (h), index (i) {}
+
+        void run() override {
+            if (host.o.pin) Thread::setCurrentThreadAffinityMask ((uint32) 1 << (index % jmin (32, SystemStats::getNumCpus())));
+            while (! threadShouldExit()) {
+                go.wait();
+                if (threadShouldExit()) break;
+                for (int i = index; i < host.active; i += host.o.threads) {
+                    auto& inst = *host.instances[(size_t) i];
+                    inst.pattern.fill (inst.midi, host.o.blockSize, host.o.sampleRate);
+                    inst.proc->processBlock (inst.buffer, inst.midi);
+                }
+                finish = Clock::now();
+                done.signal();
+            }
+        }
+
+        Host& host; const int index;
+        WaitableEvent go, done;
+        Clock::time_point finish;
+    };
+
+    const Options o;
+    const int64 baseline = residentBytes();
+    std::vector<std::unique_ptr<Instance>> instances;
+    int active = 0;
+    OwnedArray<Worker> workers;
+};
+
+void printResult (const Result& r, bool ok) {
+    std::cout << String (r.instances).paddedLeft (' ', 9)
+              << String (100.0 * r.meanLoad, 1).paddedLeft (' ', 9)
+              << String (100.0 * r.p99Load, 1).paddedLeft (' ', 9)
+              << String (100.0 * r.worstLoad, 1).paddedLeft (' ', 9)
+              << (String ((int64) r.misses) + "/" + String ((int64) r.periods)).paddedLeft (' ', 12)
+              << String (100.0 * r.instanceLoad, 2).paddedLeft (' ', 11)
+              << String (r.bytesPerInstance / (1024.0 * 1024.0), 2).paddedLeft (' ', 9)
+              << (ok ? "  ok" : "  FAIL") << std::endl;
+}
+
+var toVar (const Result& r, bool ok) {
+    auto* obj = new DynamicObject();
+    obj->setProperty ("instances", r.instances);
+    obj->setProperty ("periods", r.periods);
+    obj->setProperty ("misses", r.misses);
+    obj->setProperty ("meanLoad", r.meanLoad);
+    obj->setProperty ("p99Load", r.p99Load);
+    obj->setProperty ("worstLoad", r.worstLoad);
+    obj->setProperty ("coreSharePerInstance", r.instanceLoad);
+    obj->setProperty ("bytesPerInstance", r.bytesPerInstance);
+    obj->setProperty ("sustainable", ok);
+    return var (obj);
+}
+
+} // namespace
+
+int main (int argc, char* argv[]) {
+    const ScopedJuceInitialiser_GUI juceInit; // the processor's APVTS expects a message manager
+    StringArray args;
+    for (int i = 1; i < argc; ++i) args.add (argv[i]);
+
+    Options o;
+    o.threads = SystemStats::getNumCpus();
+    if (args.contains ("--rate"))      o.sampleRate     = option (args, "--rate").getDoubleValue();
+    if (args.contains ("--block"))     o.blockSize      = option (args, "--block").getIntValue();
+    if (args.contains ("--seconds"))   o.seconds        = option (args, "--seconds").getDoubleValue();
+    if (args.contains ("--instances")) o.fixedInstances = option (args, "--instances").getIntValue();
+    if (args.contains ("--max"))       o.maxInstances   = option (args, "--max").getIntValue();
+    if (args.contains ("--threads"))   o.threads        = option (args, "--threads").getIntValue();
+    if (args.contains ("--max-load"))  o.maxLoad        = option (args, "--max-load").getDoubleValue();
+    if (args.contains ("--max-miss"))  o.maxMissPercent = option (args, "--max-miss").getDoubleValue();
+    if (args.contains ("--midi"))      o.midi           = option (args, "--midi");
+    if (args.contains ("--presets"))   o.presets        = StringArray::fromTokens (option (args, "--presets"), ",", "\"");
+    o.presets.trim(); o.presets.removeEmptyStrings();
+    o.pin = args.contains ("--pin");
+    o.eco = args.contains ("--eco");
+
+    if (o.sampleRate < 8000.0 || o.sampleRate > 384000.0 || o.blockSize < 16 || o.blockSize > 8192 || o.seconds <= 0.0
+        || o.threads < 1 || o.maxInstances < 1 || o.fixedInstances < 0 || ! StringArray { "chords", "arp", "mpe" }.contains (o.midi)) {
+        std::cerr << "usage: MiniSynthLoad [--instances N | --max N] [--threads N] [--pin] [--rate Hz] [--block n] [--seconds s]\n"
+                     "                     [--presets a,b,...] [--midi chords|arp|mpe] [--max-load 0.85] [--max-miss 0] [--eco] [--json out.json]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::cout << SystemStats::getCpuModel() << ", " << SystemStats::getNumCpus() << " cpus; "
+              << o.threads << " worker thread(s)" << (o.pin ? " pinned" : "") << ", " << o.sampleRate << " Hz, block " << o.blockSize
+              << " (" << String (1000.0 * o.blockSize / o.sampleRate, 2) << " ms), midi " << o.midi << std::endl << std::endl
+              << "instances   mean %    p99 %  worst %      misses  core %/inst  MB/inst" << std::endl;
+
+    Host host (o);
+    Array<var> runs;
+    String error;
+    auto attempt = [&] (int n) {
+        if (! host.grow (n, error)) return false;
+        const auto r = host.run (n);
+        const bool ok = host.sustainable (r);
+        printResult (r, ok);
+        runs.add (toVar (r, ok));
+        return ok;
+    };
+
+    int best = 0;
+    if (o.fixedInstances > 0) {
+        if (attempt (o.fixedInstances)) best = o.fixedInstances;
+    } else {
+        int fail = 0;
+        for (int n = 1; error.isEmpty(); n = jmin (n * 2, o.maxInstances)) {
+            if (attempt (n)) best = n; else { fail = n; break; }
+            if (n == o.maxInstances) break;
+        }
+        while (error.isEmpty() && fail - best > 1) {
+            const int mid = (best + fail) / 2;
+            if (attempt (mid)) best = mid; else fail = mid;
+        }
+    }
+    if (error.isNotEmpty()) { std::cerr << "error: " << error << std::endl; return 1; }
+
+    std::cout << std::endl << "sustainable: " << best << " instance(s), "
+              << String ((double) best / o.threads, 2) << (o.pin ? " per core" : " per worker thread") << std::endl;
+
+    if (args.contains ("--json")) {
+        auto* meta = new DynamicObject();
+        meta->setProperty ("cpu", SystemStats::getCpuModel());
+        meta->setProperty ("cpus", SystemStats::getNumCpus());
+        meta->setProperty ("threads", o.threads);
+        meta->setProperty ("pinned", o.pin);
+        meta->setProperty ("sampleRate", o.sampleRate);
+        meta->setProperty ("blockSize", o.blockSize);
+        meta->setProperty ("midi", o.midi);
+        meta->setProperty ("eco", o.eco);
+        meta->setProperty ("maxLoad", o.maxLoad);
+        meta->setProperty ("maxMissPercent", o.maxMissPercent);
+
+        auto* root = new DynamicObject();
+        root->setProperty ("meta", var (meta));
+        root->setProperty ("runs", runs);
+        root->setProperty ("sustainableInstances", best);
+        const auto out = File::getCurrentWorkingDirectory().getChildFile (option (args, "--json"));
+        if (! out.replaceWithText (JSON::toString (var (root)))) { std::cerr << "error: cannot write " << out.getFullPathName() << std::endl; return 1; }
+    }
+    return 0;
+}
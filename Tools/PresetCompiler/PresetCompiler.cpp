@@ -0,0 +1,164 @@
+/*
+    File: PresetCompiler.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Build-time factory preset compiler. Parses the *.minisynth.json files,
+        validates every value against ParameterSpecs.h and writes a header of
+        constexpr (parameter index, normalised value) tables, plus the optional
+        "meta" (author, category, tags) for the preset browser. Any unknown ID,
+        out-of-range value or malformed meta is reported and fails the build.
+
+        Usage: MiniSynthPresetCompiler <output.h> <preset.json>...
+*/
+
+#include <juce_core/juce_core.h>
+#include "ParameterSpecs.h"
+#include <iostream>
+
+using namespace juce;
+
+namespace {
+
+struct CompiledValue { int index; float norm; };
+struct CompiledPreset { String name, symbol, author, category, tags; Array<CompiledValue> values; };
+
+File resolve (const char* path) { return File::getCurrentWorkingDirectory().getChildFile (String (path)); }
+
+void report (const File& f, const String& msg) {
+    std::cerr << f.getFullPathName() << ": error: " << msg << std::endl;
+}
+
+// Returns false (after reporting) when the value is not legal for the spec.
+bool normalise (const params::Spec& s, const var& v, const File& f, float& out) {
+    if (! (v.isInt() || v.isInt64() || v.isDouble() || v.isBool())) {
+        report (f, String ("'") + s.id + "' is not a number"); return false;
+    }
+    const double x = (double) v;
+
+    switch (s.kind) {
+        case params::Kind::Float: {
+            const float xf = (float) x;
+            if (xf < s.start || xf > s.end) {
+                report (f, String ("'") + s.id + "' = " + String (x) + " is outside [" + String (s.start) + ", " + String (s.end) + "]");
+                return false;
+            }
+            out = NormalisableRange<float> (s.start, s.end, s.interval, s.skew).convertTo0to1 (xf);
+            return true;
+        }
+        case params::Kind::Bool:
+            if (x != 0.0 && x != 1.0) { report (f, String ("'") + s.id + "' must be 0 or 1, got " + String (x)); return false; }
+            out = (float) x;
+            return true;
+        case params::Kind::Choice: {
+            const int last = (int) s.end;
+            if (x != std::floor (x) || x < 0.0 || x > (double) last) {
+                report (f, String ("'") + s.id + "' must be a choice index in [0, " + String (last) + "], got " + String (x));
+                return false;
+            }
+            out = last > 0 ? (float) x / (float) last : 0.0f;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool compile (const File& f, CompiledPreset& out) {
+    if (! f.existsAsFile()) { report (f, "file not found"); return false; }
+
+    var root;
+    auto res = JSON::parse (f.loadFileAsString(), root);
+    if (res.failed()) { report (f, "invalid JSON: " + res.getErrorMessage()); return false; }
+
+    auto* vals = root.getProperty ("values", var()).getDynamicObject();
+    if (vals == nullptr) { report (f, "missing \"values\" object"); return false; }
+
+    // Same display name as the former BinaryData scan: file base name, '_' -> ' '
+    auto base = f.getFileName().upToFirstOccurrenceOf (".", false, false);
+    out.name   = base.replace ("_", " ");
+    out.symbol = "preset_" + base.retainCharacters ("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_");
+
+    // Optional meta: strings, tags as an array (joined with ',' in the table)
+    bool ok = true;
+    const auto meta = root.getProperty ("meta", var());
+    if (! meta.isVoid()) {
+        const auto tags = meta.getProperty ("tags", var());
+        if (! meta.isObject()) { report (f, "\"meta\" must be an object"); ok = false; }
+        else if (! tags.isVoid() && ! tags.isArray()) { report (f, "\"meta.tags\" must be an array of strings"); ok = false; }
+        else {
+            out.author   = meta.getProperty ("author", var()).toString();
+            out.category = meta.getProperty ("category", var()).toString();
+            StringArray t;
+            if (const auto* a = tags.getArray()) for (const auto& x : *a) t.add (x.toString().trim());
+            out.tags = t.joinIntoString (",");
+        }
+    }
+
+    for (auto& p : vals->getProperties()) {
+        const auto id = p.name.toString();
+        const int index = params::indexOf (id.toRawUTF8());
+        if (index < 0) { report (f, "unknown parameter '" + id + "'"); ok = false; continue; }
+        if (params::specs[index].output) { report (f, "'" + id + "' is read-only"); ok = false; continue; }
+
+        float norm = 0.0f;
+        if (normalise (params::specs[index], p.value, f, norm)) out.values.add ({ index, norm });
+        else ok = false;
+    }
+    return ok;
+}
+
+String emit (const Array<CompiledPreset>& list) {
+    String h;
+    h << "// Generated by MiniSynthPresetCompiler from Resources/Presets/Factory. Do not edit.\n"
+      << "#pragma once\n\n"
+      << "namespace presets { namespace factory {\n\n"
+      << "struct Value  { int index; float norm; };\n"
+      << "struct Preset { const char* name; const Value* values; int numValues; const char* author; const char* category; const char* tags; };\n\n";
+
+    for (auto& p : list) {
+        h << "static constexpr Value " << p.symbol << "[] = {\n";
+        for (auto& v : p.values)
+            h << "    { " << v.index << ", " << String (v.norm, 9) << "f }, // " << params::specs[v.index].id << "\n";
+        h << "};\n\n";
+    }
+
+    h << "static constexpr int numPresets = " << list.size() << ";\n"
+      << "static constexpr Preset list[] = {\n";
+    for (auto& p : list)
+        h << "    { " << p.name.quoted() << ", " << p.symbol << ", " << p.values.size() << ", "
+          << p.author.quoted() << ", " << p.category.quoted() << ", " << p.tags.quoted() << " },\n";
+    if (list.isEmpty())
+        h << "    { nullptr, nullptr, 0, nullptr, nullptr, nullptr },\n";
+    h << "};\n\n} } // namespace presets::factory\n";
+    return h;
+}
+
+} // namespace
+
+int main (int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: MiniSynthPresetCompiler <output.h> <preset.json>..." << std::endl;
+        return 2;
+    }
+
+    Array<File> inputs;
+    for (int i = 2; i < argc; ++i) inputs.add (resolve (argv[i]));
+    std::sort (inputs.begin(), inputs.end(), [](const File& a, const File& b) { return a.getFileName() < b.getFileName(); });
+
+    Array<CompiledPreset> compiled;
+    bool ok = true;
+    for (auto& f : inputs) {
+        CompiledPreset p;
+        if (compile (f, p)) compiled.add (p); else ok = false;
+    }
+    if (! ok) return 1;
+
+    auto out = resolve (argv[1]);
+    out.getParentDirectory().createDirectory();
+    if (! out.replaceWithText (emit (compiled))) {
+        std::cerr << out.getFullPathName() << ": error: cannot write output" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,255 @@
+/*
+    File: Render.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Headless offline renderer. Runs MiniSynthAudioProcessor (same Source/
+        code as the plugin) over a Standard MIDI File with a preset loaded and
+        writes a WAV, as fast as the CPU allows. Batch mode renders a list of
+        jobs in parallel, one processor instance per job. --note-parallel
+        renders the notes of one job across cores instead (NoteParallelRenderer:
+        no voice limit, output identical for any --threads).
+
+        Usage:
+          MiniSynthRender --preset <name|file> --midi <in.mid> --out <out.wav> [options]
+                          [--automation <points.json>] [--note-parallel [--threads N]]
+          MiniSynthRender --batch <jobs.json> [--threads N] [options]
+
+        --preset  factory/user preset name, a *.minisynth.json / .xml preset, or
+                  any other file holding a saved plugin state blob
+        options:  --rate <Hz> (48000)  --block <samples> (512)  --bits <16|24|32> (24)
+                  --tail <seconds> (2)
+        jobs.json: [ { "preset": "...", "midi": "...", "out": "...", "automation": "..." }, ... ]
+                   relative paths resolve against the jobs file's folder
+        points.json: [ { "time": <seconds>, "id": "<parameter id>", "value": <plain> }, ... ]
+*/
+
+#include "JuceIncludes.h"
+#include "PluginProcessor.h"
+#include "dsp/NoteParallelRenderer.h"
+#include <iostream>
+
+using namespace juce;
+
+namespace {
+
+struct Settings {
+    double sampleRate = 48000.0; int blockSize = 512; int bits = 24; double tailSeconds = 2.0;
+    bool noteParallel = false; int noteThreads = 1;
+};
+struct Job { String preset; File midi, out, automation; };
+using Automation = std::vector<NoteParallelRenderer::AutomationPoint>;
+
+CriticalSection consoleLock;
+
+void print (const String& msg, bool error = false) {
+    const ScopedLock sl (consoleLock);
+    (error ? std::cerr : std::cout) << msg << std::endl;
+}
+
+bool loadPreset (MiniSynthAudioProcessor& proc, const String& preset, const File& baseDir, String& error) {
+    const auto f = baseDir.getChildFile (preset);
+    if (f.existsAsFile()) {
+        if (f.hasFileExtension ("json;xml")) {
+            if (proc.applyPresetFile (f)) return true;
+            error = "cannot parse preset " + f.getFullPathName(); return false;
+        }
+        MemoryBlock state;
+        if (! f.loadFileAsData (state)) { error = "cannot read state " + f.getFullPathName(); return false; }
+        proc.setStateInformation (state.getData(), (int) state.getSize());
+        proc.finishWavetableImports(); // no message loop here to install them later
+        return true;
+    }
+
+    const int index = proc.getPresetNames().indexOf (preset, true);
+    if (index < 0) { error = "unknown preset '" + preset + "'"; return false; }
+    proc.applyPresetByIndex (index);
+    return true;
+}
+
+bool loadMidi (const File& f, MidiMessageSequence& seq, String& error) {
+    FileInputStream in (f);
+    MidiFile file;
+    if (! in.openedOk() || ! file.readFrom (in)) { error = "cannot read MIDI file " + f.getFullPathName(); return false; }
+
+    file.convertTimestampTicksToSeconds();
+    for (int t = 0; t < file.getNumTracks(); ++t) seq.addSequence (*file.getTrack (t), 0.0);
+    return true;
+}
+
+bool loadAutomation (const File& f, Automation& points, String& error) {
+    var root;
+    if (JSON::parse (f.loadFileAsString(), root).failed() || ! root.isArray()) {
+        error = f.getFullPathName() + ": expected a JSON array of automation points"; return false;
+    }
+    for (auto& p : *root.getArray()) {
+        const auto id = p["id"].toString();
+        const int index = params::indexOf (id.toRawUTF8());
+        if (index < 0) { error = f.getFullPathName() + ": unknown parameter '" + id + "'"; return false; }
+        points.push_back ({ (double) p["time"], index, (float) p["value"] });
+    }
+    std::stable_sort (points.begin(), points.end(), [] (const auto& a, const auto& b) { return a.seconds < b.seconds; });
+    return true;
+}
+
+// Processor path: host-style automation, applied before the block containing each point
+int64 renderBlocks (MiniSynthAudioProcessor& proc, const MidiMessageSequence& seq, const Automation& automation,
+                    const Settings& s, AudioFormatWriter& writer) {
+    proc.prepareToPlay (s.sampleRate, s.blockSize);
+
+    const auto total = (int64) std::ceil ((seq.getEndTime() + s.tailSeconds) * s.sampleRate);
+    AudioBuffer<float> buffer (2, s.blockSize);
+    MidiBuffer midi;
+    int next = 0;
+    size_t nextPoint = 0;
+
+    for (int64 pos = 0; pos < total; pos += s.blockSize) {
+        const int n = (int) jmin ((int64) s.blockSize, total - pos);
+
+        for (; nextPoint < automation.size() && (int64) std::llround (automation[nextPoint].seconds * s.sampleRate) < pos + n; ++nextPoint)
+            if (auto* param = dynamic_cast<RangedAudioParameter*> (proc.getParameters()[automation[nextPoint].index]))
+                param->setValueNotifyingHost (param->convertTo0to1 (automation[nextPoint].value));
+
+        midi.clear();
+        for (; next < seq.getNumEvents(); ++next) {
+            const auto& m = seq.getEventPointer (next)->message;
+            const auto at = (int64) std::llround (m.getTimeStamp() * s.sampleRate);
+            if (at >= pos + n) break;
+            if (! m.isMetaEvent()) midi.addEvent (m, (int) jmax ((int64) 0, at - pos));
+        }
+
+        buffer.setSize (2, n, false, false, true);
+        proc.processBlock (buffer, midi);
+        writer.writeFromAudioSampleBuffer (buffer, 0, n);
+    }
+    proc.releaseResources();
+    return total;
+}
+
+// Note-parallel path: same voice code and parameter state, one virtual voice per note
+int64 renderNotes (MiniSynthAudioProcessor& proc, const MidiMessageSequence& seq, const Automation& automation,
+                   const Settings& s, AudioFormatWriter& writer) {
+    proc.prepareToPlay (s.sampleRate, s.blockSize); // settles the chunk size and morph blend
+
+    NoteParallelRenderer engine (s.sampleRate, proc.getRenderChunkSize());
+    engine.prepare (seq, proc.getParamSnapshot(), automation, s.tailSeconds);
+    proc.releaseResources();
+
+    AudioBuffer<float> out (2, (int) engine.getLengthInSamples());
+    engine.render (out, s.noteThreads);
+    writer.writeFromAudioSampleBuffer (out, 0, out.getNumSamples());
+    return engine.getLengthInSamples();
+}
+
+bool render (const Job& job, const Settings& s, const File& baseDir, String& error) {
+    MiniSynthAudioProcessor proc;
+    proc.setNonRealtime (true);
+    proc.setPlayConfigDetails (0, 2, s.sampleRate, s.blockSize);
+
+    MidiMessageSequence seq;
+    Automation automation;
+    if (! loadPreset (proc, job.preset, baseDir, error) || ! loadMidi (job.midi, seq, error)) return false;
+    if (job.automation != File() && ! loadAutomation (job.automation, automation, error)) return false;
+
+    job.out.getParentDirectory().createDirectory();
+    job.out.deleteFile();
+    auto stream = std::make_unique<FileOutputStream> (job.out);
+    if (stream->failedToOpen()) { error = "cannot write " + job.out.getFullPathName(); return false; }
+
+    WavAudioFormat wav;
+    std::unique_ptr<AudioFormatWriter> writer (wav.createWriterFor (stream.get(), s.sampleRate, 2, s.bits, {}, 0));
+    if (writer == nullptr) { error = "unsupported WAV format (" + String (s.bits) + " bit)"; return false; }
+    stream.release(); // owned by the writer now
+
+    const auto startTime = Time::getMillisecondCounterHiRes();
+    const auto total = s.noteParallel ? renderNotes  (proc, seq, automation, s, *writer)
+                                      : renderBlocks (proc, seq, automation, s, *writer);
+
+    const double seconds = (Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+    print (job.out.getFullPathName() + "  " + String ((double) total / s.sampleRate, 1) + " s audio, "
+         + String ((double) total / s.sampleRate / jmax (1.0e-6, seconds), 1) + "x realtime");
+    return true;
+}
+
+bool parseJobs (const File& f, Array<Job>& jobs) {
+    var root;
+    if (JSON::parse (f.loadFileAsString(), root).failed() || ! root.isArray()) {
+        print (f.getFullPathName() + ": error: expected a JSON array of jobs", true); return false;
+    }
+    const auto dir = f.getParentDirectory();
+    for (auto& j : *root.getArray()) {
+        Job job { j["preset"].toString(), dir.getChildFile (j["midi"].toString()), dir.getChildFile (j["out"].toString()),
+                  j["automation"].toString().isNotEmpty() ? dir.getChildFile (j["automation"].toString()) : File() };
+        if (job.preset.isEmpty() || j["midi"].toString().isEmpty() || j["out"].toString().isEmpty()) {
+            print (f.getFullPathName() + ": error: every job needs \"preset\", \"midi\" and \"out\"", true); return false;
+        }
+        jobs.add (job);
+    }
+    return true;
+}
+
+// "--name value" pairs; empty when absent
+String option (const StringArray& args, const char* name) {
+    const int i = args.indexOf (name);
+    return i >= 0 && i + 1 < args.size() ? args[i + 1] : String();
+}
+
+} // namespace
+
+int main (int argc, char* argv[]) {
+    const ScopedJuceInitialiser_GUI juceInit; // the processor's APVTS expects a message manager
+    StringArray args;
+    for (int i = 1; i < argc; ++i) args.add (argv[i]);
+
+    Settings s;
+    if (args.contains ("--rate"))  s.sampleRate  = option (args, "--rate").getDoubleValue();
+    if (args.contains ("--block")) s.blockSize   = option (args, "--block").getIntValue();
+    if (args.contains ("--bits"))  s.bits        = option (args, "--bits").getIntValue();
+    if (args.contains ("--tail"))  s.tailSeconds = option (args, "--tail").getDoubleValue();
+    s.noteParallel = args.contains ("--note-parallel");
+
+    if (s.sampleRate < 8000.0 || s.sampleRate > 384000.0 || s.blockSize < 1 || s.blockSize > 8192 || s.tailSeconds < 0.0) {
+        print ("error: --rate must be 8000..384000, --block 1..8192, --tail >= 0", true); return 1;
+    }
+
+    const auto cwd = File::getCurrentWorkingDirectory();
+
+    if (args.contains ("--batch")) {
+        const auto jobsFile = cwd.getChildFile (option (args, "--batch"));
+        Array<Job> jobs;
+        if (! parseJobs (jobsFile, jobs)) return 1;
+
+        const int threads = args.contains ("--threads") ? jmax (1, option (args, "--threads").getIntValue())
+                                                        : SystemStats::getNumCpus();
+        std::atomic<int> failures { 0 };
+        {
+            ThreadPool pool (threads);
+            for (const auto& job : jobs)
+                pool.addJob ([job, s, dir = jobsFile.getParentDirectory(), &failures] {
+                    String error;
+                    if (! render (job, s, dir, error)) { print (job.out.getFullPathName() + ": error: " + error, true); ++failures; }
+                    return ThreadPoolJob::jobHasFinished;
+                });
+            while (pool.getNumJobs() > 0) Thread::sleep (20);
+        }
+        print (String (jobs.size() - failures.load()) + "/" + String (jobs.size()) + " jobs rendered");
+        return failures.load() == 0 ? 0 : 1;
+    }
+
+    if (! args.contains ("--preset") || ! args.contains ("--midi") || ! args.contains ("--out")) {
+        print ("usage: MiniSynthRender --preset <name|file> --midi <in.mid> --out <out.wav> [--rate Hz] [--block n] [--bits n] [--tail s]\n"
+             "                       [--automation points.json] [--note-parallel [--threads n]]\n"
+             "       MiniSynthRender --batch <jobs.json> [--threads n] [--rate Hz] [--block n] [--bits n] [--tail s]", true);
+        return 1;
+    }
+
+    Job job { option (args, "--preset"), cwd.getChildFile (option (args, "--midi")),
+              cwd.getChildFile (option (args, "--out")),
+              args.contains ("--automation") ? cwd.getChildFile (option (args, "--automation")) : File() };
+    if (s.noteParallel)
+        s.noteThreads = args.contains ("--threads") ? jmax (1, option (args, "--threads").getIntValue()) : SystemStats::getNumCpus();
+    String error;
+    if (! render (job, s, cwd, error)) { print ("error: " + error, true); return 1; }
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+    File: RtCheck.cpp
+    Project: MiniSynth
+    Revision: 1.0.0
+    Date: 2026-10-18
+    Description:
+        Real-time safety stress run (built with MS_RT_CHECK=1). Drives
+        MiniSynthAudioProcessor::processBlock through note storms, MPE and
+        controller floods, sustain / all-notes-off, random block sizes,
+        parameter bursts, preset changes with A/B morph, render chunk and
+        sample-rate changes, an upsampled engine rate, note freezing, and
+        multi-timbral passes whose part worker threads are checked like the
+        audio thread. Preparation and preset loading happen outside
+        processBlock, as in a host; anything processBlock allocates or locks
+        is printed with its call stack and fails the run (exit status 1).
+
+        Usage: MiniSynthRtCheck [--blocks <per preset, 200>] [--seed <n>]
+*/
+
+#include "JuceIncludes.h"
+#include "PluginProcessor.h"
+#include "diag/RealtimeCheck.h"
+#include <iostream>
+
+using namespace juce;
+
+namespace {
+
+// One block's worth of hostile MIDI: dense notes on all channels, wheel /
+// pressure / CC74 streams, sustain toggles and the odd all-notes-off
+void fillStorm (MidiBuffer& midi, Random& rng, int numSamples) {
+    midi.clear();
+    const int events = rng.nextInt (256);
+    for (int e = 0; e < events; ++e) {
+        const int at = rng.nextInt (numSamples);
+        const int ch = 1 + rng.nextInt (16);
+        switch (rng.nextInt (10)) {
+            case 0: case 1: case 2: midi.addEvent (MidiMessage::noteOn (ch, rng.nextInt (128), (uint8) (1 + rng.nextInt (127))), at); break;
+            case 3: case 4:         midi.addEvent (MidiMessage::noteOff (ch, rng.nextInt (128)), at); break;
+            case 5:                 midi.addEvent (MidiMessage::pitchWheel (ch, rng.nextInt (16384)), at); break;
+            case 6:                 midi.addEvent (MidiMessage::channelPressureChange (ch, rng.nextInt (128)), at); break;
+            case 7:                 midi.addEvent (MidiMessage::controllerEvent (ch, 74, rng.nextInt (128)), at); break;
+            case 8:                 midi.addEvent (MidiMessage::controllerEvent (ch, 64, rng.nextBool() ? 127 : 0), at); break;
+            default:                midi.addEvent (rng.nextInt (50) == 0 ? MidiMessage::allNotesOff (ch)
+                                                                         : MidiMessage::aftertouchChange (ch, rng.nextInt (128), rng.nextInt (128)), at); break;
+        }
+    }
+}
+
+// One pass of the matrix: host rate, render chunk, multi-timbral parts,
+// engine rate (0 = host rate) and note freezing
+struct Pass { double rate; int chunk, parts; double engineRate; bool freeze; };
+
+// Host-style automation burst on a few random parameters (message thread)
+void automate (MiniSynthAudioProcessor& proc, Random& rng) {
+    const auto& params = proc.getParameters();
+    for (int i = 0; i < 8; ++i)
+        params[rng.nextInt (params.size())]->setValueNotifyingHost (rng.nextFloat());
+}
+
+} // namespace
+
+int main (int argc, char* argv[]) {
+    const ScopedJuceInitialiser_GUI juceInit; // the processor's APVTS expects a message manager
+
+    StringArray args;
+    for (int i = 1; i < argc; ++i) args.add (argv[i]);
+    auto option = [&args] (const char* name, int def) {
+        const int i = args.indexOf (name);
+        return i >= 0 && i + 1 < args.size() ? args[i + 1].getIntValue() : def;
+    };
+    const int blocksPerPreset = jmax (1, option ("--blocks", 200));
+    Random rng (option ("--seed", 1));
+
+    MiniSynthAudioProcessor proc;
+    const auto presets = proc.getPresetNames();
+    const Pass passes[] = {
+        { 44100.0, 64, 1, 0.0, false }, { 48000.0, 16, 1, 0.0, false }, { 96000.0, 256, 1, 0.0, false }, { 22050.0, 1024, 1, 0.0, false },
+        { 48000.0, 64, 4, 0.0, false }, { 44100.0, 16, 16, 0.0, false },
+        { 44100.0, 64, 1, 96000.0, false }, { 48000.0, 32, 4, 96000.0, false },
+        { 48000.0, 64, 1, 0.0, true }, { 44100.0, 64, 4, 88200.0, true },
+    };
+    constexpr int maxBlock = 2048;
+
+    AudioBuffer<float> buffer (2, maxBlock);
+    MidiBuffer midi;
+    midi.ensureSize (64 * 1024);
+    int64 blocks = 0;
+
+    for (const auto& pass : passes) {
+        proc.setRenderChunkSize (pass.chunk);
+        proc.setNumParts (pass.parts);
+        proc.setEngineRate (pass.engineRate);
+        proc.setPlayConfigDetails (0, 2, pass.rate, maxBlock);
+        proc.prepareToPlay (pass.rate, maxBlock);
+        std::cout << "rate " << pass.rate << " Hz, chunk " << proc.getRenderChunkSize() << ", parts " << proc.getNumParts()
+                  << ", engine " << (proc.isEngineRateActive() ? String (pass.engineRate) + " Hz" : String ("off"))
+                  << ", freeze " << (pass.freeze ? "on" : "off") << std::endl;
+        auto* freeze = proc.apvts.getParameter (ids::freezeOn);
+
+        for (int p = 0; p < presets.size(); ++p) {
+            proc.applyPresetByIndex (p);
+            for (int part = 2; part <= proc.getNumParts(); ++part) proc.setPartPreset (part, (p + part) % presets.size());
+            if (p % 2 == 1) { // morph between this preset and the next one
+                proc.setMorphSlot (0, p);
+                proc.setMorphSlot (1, (p + 1) % presets.size());
+                if (auto* on = proc.apvts.getParameter (ids::morphOn)) on->setValueNotifyingHost (1.0f);
+            }
+
+            for (int b = 0; b < blocksPerPreset; ++b, ++blocks) {
+                const int n = rng.nextInt (8) == 0 ? maxBlock : 1 + rng.nextInt (maxBlock);
+                buffer.setSize (2, n, false, false, true);
+                fillStorm (midi, rng, n);
+                if (b % 16 == 0) {
+                    automate (proc, rng);
+                    freeze->setValueNotifyingHost (pass.freeze ? 1.0f : 0.0f); // the burst may have flipped it
+                }
+                proc.processBlock (buffer, midi);
+            }
+        }
+        proc.releaseResources();
+    }
+
+    const auto violations = RealtimeCheck::getViolations();
+    std::cout << blocks << " blocks processed, " << violations.size() << " offending call site(s)" << std::endl;
+    if (const auto lost = proc.getVoiceEventsDropped(); lost > 0)
+        std::cout << lost << " voice event(s) lost to full voice queues" << std::endl;
+    for (const auto& v : violations)
+        std::cout << std::endl << v.kind << " (" << v.count << "x) on the audio thread:" << std::endl << v.stack << std::endl;
+
+    return violations.empty() ? 0 : 1;
+}